@@ -0,0 +1,110 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "../src/engine/AllocationTracker.h"
+#include "../src/engine/SpatialIndex.h"
+
+// Measures SpatialIndex insert, move and query costs at increasing entity
+// counts. The map is square and sized to hold about one entity per tile.
+// In a CIV_TRACK_ALLOCATIONS build the queries must not allocate at all,
+// and the benchmark fails if they do.
+
+typedef std::chrono::steady_clock Clock;
+
+static double nanosPerOp(Clock::time_point start, size_t ops) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / ops;
+}
+
+static bool run(int entityCount) {
+    int side = (int) std::sqrt((double) entityCount);
+    std::mt19937 rng(1234);
+    std::uniform_int_distribution<int> coord(0, side - 1);
+    std::uniform_int_distribution<int> step(-1, 1);
+
+    std::vector<Entity> entities(entityCount);
+    std::vector<int> xs(entityCount);
+    std::vector<int> ys(entityCount);
+    for (int i = 0; i < entityCount; i++) {
+        entities[i] = Entity{(uint32_t) i, 0};
+        xs[i] = coord(rng);
+        ys[i] = coord(rng);
+    }
+
+    SpatialIndex index;
+    std::vector<Entity> results;
+    results.reserve(1024);
+    size_t found = 0;
+    const int queries = 100000;
+
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < entityCount; i++) {
+        index.insert(entities[i], xs[i], ys[i]);
+    }
+    double insertNs = nanosPerOp(start, entityCount);
+
+    start = Clock::now();
+    for (int i = 0; i < entityCount; i++) {
+        xs[i] += step(rng);
+        ys[i] += step(rng);
+        index.move(entities[i], xs[i], ys[i]);
+    }
+    double moveNs = nanosPerOp(start, entityCount);
+
+    AllocationTracker &allocations = AllocationTracker::instance();
+    allocations.beginFrame();
+
+    start = Clock::now();
+    for (int i = 0; i < queries; i++) {
+        results.clear();
+        found += index.queryPoint(coord(rng), coord(rng), &results);
+    }
+    double pointNs = nanosPerOp(start, queries);
+
+    start = Clock::now();
+    for (int i = 0; i < queries; i++) {
+        results.clear();
+        found += index.queryRadius(coord(rng), coord(rng), 3, &results);
+    }
+    double radiusNs = nanosPerOp(start, queries);
+
+    start = Clock::now();
+    for (int i = 0; i < queries; i++) {
+        int x = coord(rng);
+        int y = coord(rng);
+        results.clear();
+        found += index.queryRect(x, y, x + 15, y + 8, &results);
+    }
+    double rectNs = nanosPerOp(start, queries);
+
+    allocations.endFrame();
+    uint64_t queryAllocations = allocations.getLastFrame().allocations;
+
+    start = Clock::now();
+    for (int i = 0; i < entityCount; i++) {
+        index.remove(entities[i]);
+    }
+    double removeNs = nanosPerOp(start, entityCount);
+
+    printf("%8d entities  insert %7.1f ns  move %7.1f ns  point %7.1f ns  "
+           "radius(3) %8.1f ns  rect(16x9) %8.1f ns  remove %7.1f ns  (%zu hits)\n",
+           entityCount, insertNs, moveNs, pointNs, radiusNs, rectNs, removeNs, found);
+
+    if (queryAllocations > 0) {
+        printf("%8d entities  queries made %llu heap allocations, budget is 0\n",
+               entityCount, (unsigned long long) queryAllocations);
+        return false;
+    }
+
+    return true;
+}
+
+int main() {
+    bool withinBudget = run(10000);
+    withinBudget = run(100000) && withinBudget;
+    withinBudget = run(1000000) && withinBudget;
+
+    return withinBudget ? 0 : 1;
+}
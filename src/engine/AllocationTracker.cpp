@@ -0,0 +1,262 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "AllocationTracker.h"
+
+namespace {
+
+struct Counters {
+    std::atomic<uint64_t> allocations;
+    std::atomic<uint64_t> frees;
+    std::atomic<uint64_t> bytes;
+    std::atomic<int64_t> liveBytes;
+    std::atomic<int64_t> peakBytes;
+};
+
+// Zero-initialized before any constructor runs, so allocations made during
+// static initialization are counted safely
+Counters gSubsystems[NUM_ALLOC_SUBSYSTEMS];
+Counters gTotal;
+Counters gFrame;
+thread_local AllocSubsystem tSubsystem = ALLOC_GENERAL;
+
+const char *SUBSYSTEM_NAMES[NUM_ALLOC_SUBSYSTEMS] = {
+        "general",
+        "assets",
+        "ui",
+        "render",
+        "world",
+        "pathfinding",
+        "territory",
+        "save"
+};
+
+// Saves run on background threads at their own pace, so charging them to
+// whichever frame happens to be open would make frame counts depend on timing
+bool inFrame(AllocSubsystem subsystem) {
+    return subsystem != ALLOC_SAVE;
+}
+
+AllocationStats snapshot(const Counters &counters) {
+    return AllocationStats{counters.allocations.load(std::memory_order_relaxed),
+                           counters.frees.load(std::memory_order_relaxed),
+                           counters.bytes.load(std::memory_order_relaxed),
+                           counters.liveBytes.load(std::memory_order_relaxed),
+                           counters.peakBytes.load(std::memory_order_relaxed)};
+}
+
+#if defined(CIV_TRACK_ALLOCATIONS)
+
+// Prepended to every block so frees can be charged to the subsystem that
+// allocated, keeping each subsystem's live bytes balanced
+struct BlockHeader {
+    uint64_t size;
+    uint32_t subsystem;
+    uint32_t padding;
+};
+
+const size_t HEADER_BYTES = alignof(std::max_align_t) > sizeof(BlockHeader)
+                            ? alignof(std::max_align_t)
+                            : sizeof(BlockHeader);
+
+void raisePeak(std::atomic<int64_t> &peak, int64_t live) {
+    int64_t seen = peak.load(std::memory_order_relaxed);
+    while (live > seen && !peak.compare_exchange_weak(seen, live, std::memory_order_relaxed)) {
+    }
+}
+
+void *trackedAllocate(size_t size) {
+    // Fails like malloc would instead of wrapping to a tiny block
+    if (size > SIZE_MAX - HEADER_BYTES) {
+        return nullptr;
+    }
+
+    void *block = malloc(HEADER_BYTES + size);
+    if (block == nullptr) {
+        return nullptr;
+    }
+
+    AllocSubsystem subsystem = tSubsystem;
+    auto *header = (BlockHeader *) block;
+    header->size = size;
+    header->subsystem = (uint32_t) subsystem;
+
+    Counters *counters[] = {&gSubsystems[subsystem], &gTotal, inFrame(subsystem) ? &gFrame : nullptr};
+    for (Counters *c : counters) {
+        if (c == nullptr) {
+            continue;
+        }
+
+        c->allocations.fetch_add(1, std::memory_order_relaxed);
+        c->bytes.fetch_add(size, std::memory_order_relaxed);
+        int64_t live = c->liveBytes.fetch_add((int64_t) size, std::memory_order_relaxed) + (int64_t) size;
+        raisePeak(c->peakBytes, live);
+    }
+
+    return (uint8_t *) block + HEADER_BYTES;
+}
+
+void *allocateOrThrow(size_t size) {
+    for (;;) {
+        void *memory = trackedAllocate(size);
+        if (memory != nullptr) {
+            return memory;
+        }
+
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void trackedFree(void *memory) {
+    if (memory == nullptr) {
+        return;
+    }
+
+    void *block = (uint8_t *) memory - HEADER_BYTES;
+    auto *header = (BlockHeader *) block;
+    auto size = (int64_t) header->size;
+
+    auto subsystem = (AllocSubsystem) header->subsystem;
+    Counters *counters[] = {&gSubsystems[subsystem], &gTotal, inFrame(subsystem) ? &gFrame : nullptr};
+    for (Counters *c : counters) {
+        if (c == nullptr) {
+            continue;
+        }
+
+        c->frees.fetch_add(1, std::memory_order_relaxed);
+        c->liveBytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    free(block);
+}
+
+#endif
+
+}
+
+#if defined(CIV_TRACK_ALLOCATIONS)
+
+void *operator new(std::size_t size) {
+    return allocateOrThrow(size);
+}
+
+void *operator new[](std::size_t size) {
+    return allocateOrThrow(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return trackedAllocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return trackedAllocate(size);
+}
+
+void operator delete(void *memory) noexcept {
+    trackedFree(memory);
+}
+
+void operator delete[](void *memory) noexcept {
+    trackedFree(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+    trackedFree(memory);
+}
+
+void operator delete[](void *memory, std::size_t) noexcept {
+    trackedFree(memory);
+}
+
+void operator delete(void *memory, const std::nothrow_t &) noexcept {
+    trackedFree(memory);
+}
+
+void operator delete[](void *memory, const std::nothrow_t &) noexcept {
+    trackedFree(memory);
+}
+
+#endif
+
+AllocationTracker &AllocationTracker::instance() {
+    static AllocationTracker tracker;
+    return tracker;
+}
+
+AllocationTracker::AllocationTracker() :
+        last() {
+
+}
+
+bool AllocationTracker::isEnabled() {
+#if defined(CIV_TRACK_ALLOCATIONS)
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char *AllocationTracker::getSubsystemName(AllocSubsystem subsystem) {
+    return SUBSYSTEM_NAMES[subsystem];
+}
+
+void AllocationTracker::beginFrame() {
+    // Live bytes carry over between frames; the peak starts from them
+    int64_t live = gTotal.liveBytes.load(std::memory_order_relaxed);
+    for (int i = 0; i < NUM_ALLOC_SUBSYSTEMS; i++) {
+        if (!inFrame((AllocSubsystem) i)) {
+            live -= gSubsystems[i].liveBytes.load(std::memory_order_relaxed);
+        }
+    }
+
+    gFrame.allocations.store(0, std::memory_order_relaxed);
+    gFrame.frees.store(0, std::memory_order_relaxed);
+    gFrame.bytes.store(0, std::memory_order_relaxed);
+    gFrame.liveBytes.store(live, std::memory_order_relaxed);
+    gFrame.peakBytes.store(live, std::memory_order_relaxed);
+}
+
+void AllocationTracker::endFrame() {
+    last = snapshot(gFrame);
+}
+
+const AllocationStats &AllocationTracker::getLastFrame() const {
+    return last;
+}
+
+AllocationStats AllocationTracker::getSubsystem(AllocSubsystem subsystem) const {
+    return snapshot(gSubsystems[subsystem]);
+}
+
+AllocationStats AllocationTracker::getTotal() const {
+    return snapshot(gTotal);
+}
+
+void AllocationTracker::printSubsystems() const {
+    for (int i = 0; i < NUM_ALLOC_SUBSYSTEMS; i++) {
+        AllocationStats stats = getSubsystem((AllocSubsystem) i);
+        if (stats.allocations > 0) {
+            printf("  %-12s %10llu allocs %12.1f KB  peak %10.1f KB\n",
+                   SUBSYSTEM_NAMES[i],
+                   (unsigned long long) stats.allocations,
+                   stats.bytes / 1024.0,
+                   stats.peakBytes / 1024.0);
+        }
+    }
+}
+
+AllocationScope::AllocationScope(AllocSubsystem subsystem) :
+        previous(tSubsystem) {
+    tSubsystem = subsystem;
+}
+
+AllocationScope::~AllocationScope() {
+    tSubsystem = previous;
+}
@@ -0,0 +1,79 @@
+#ifndef CIV_ALLOCATIONTRACKER_H
+#define CIV_ALLOCATIONTRACKER_H
+
+#include <cstdint>
+
+// Subsystem an allocation is charged to, set per thread by AllocationScope
+enum AllocSubsystem {
+    ALLOC_GENERAL,
+    ALLOC_ASSETS,
+    ALLOC_UI,
+    ALLOC_RENDER,
+    ALLOC_WORLD,
+    ALLOC_PATHFINDING,
+    ALLOC_TERRITORY,
+    ALLOC_SAVE,
+    NUM_ALLOC_SUBSYSTEMS
+};
+
+struct AllocationStats {
+    uint64_t allocations;
+    uint64_t frees;
+    uint64_t bytes;
+    // Bytes still allocated, and the most that were at any one time
+    int64_t liveBytes;
+    int64_t peakBytes;
+};
+
+// Heap allocation counters. Building with CIV_TRACK_ALLOCATIONS replaces
+// the global operator new and delete to feed them; otherwise every count
+// stays zero and isEnabled() is false.
+//
+// Totals are kept per subsystem for the whole run and for all threads per
+// frame. A frame is whatever lies between beginFrame() and endFrame(): a
+// rendered frame in civ, a turn in civ_sim. ALLOC_SAVE is left out of the
+// frame totals: saves run on their own thread and overlap whichever frame
+// is open when they allocate.
+class AllocationTracker {
+public:
+    static AllocationTracker &instance();
+
+    static bool isEnabled();
+
+    static const char *getSubsystemName(AllocSubsystem subsystem);
+
+    void beginFrame();
+
+    void endFrame();
+
+    const AllocationStats &getLastFrame() const;
+
+    AllocationStats getSubsystem(AllocSubsystem subsystem) const;
+
+    AllocationStats getTotal() const;
+
+    // Prints one line per subsystem that has allocated, for end-of-run reports
+    void printSubsystems() const;
+
+private:
+    AllocationTracker();
+
+    AllocationStats last;
+};
+
+// Charges the calling thread's allocations to a subsystem until destroyed
+class AllocationScope {
+public:
+    explicit AllocationScope(AllocSubsystem subsystem);
+
+    ~AllocationScope();
+
+    AllocationScope(const AllocationScope &) = delete;
+
+    AllocationScope &operator=(const AllocationScope &) = delete;
+
+private:
+    AllocSubsystem previous;
+};
+
+#endif
@@ -0,0 +1,190 @@
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include "AssetPack.h"
+#include "Lz4.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Image payloads must hold exactly width * height RGBA32 pixels, since
+// callers upload and scan them by their dimensions alone
+static bool isImageSizeValid(const AssetPackEntry &entry) {
+    if (entry.width == 0 || entry.height == 0 ||
+        entry.width > INT_MAX / 4 / entry.height) {
+        return false;
+    }
+
+    uint64_t pixelBytes = (uint64_t) entry.width * entry.height * 4;
+    if (entry.flags & ASSET_FLAG_LZ4) {
+        // The decompressor works in int sizes
+        return entry.rawSize == pixelBytes && entry.size <= INT_MAX;
+    }
+
+    return entry.size == pixelBytes;
+}
+
+AssetPack::AssetPack() {
+    mData = nullptr;
+    mSize = 0;
+    mEntries = nullptr;
+    mEntryCount = 0;
+#if defined(_WIN32)
+    mFile = nullptr;
+    mMapping = nullptr;
+#else
+    mFile = -1;
+#endif
+}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+bool AssetPack::open(std::string path) {
+    close();
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file, &fileSize);
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        printf("Unable to map asset pack %s!\n", path.c_str());
+        CloseHandle(file);
+        return false;
+    }
+
+    mFile = file;
+    mMapping = mapping;
+    mSize = (size_t) fileSize.QuadPart;
+    mData = (const uint8_t *) MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(file, &info) != 0 || info.st_size == 0) {
+        printf("Unable to stat asset pack %s!\n", path.c_str());
+        ::close(file);
+        return false;
+    }
+
+    void *mapped = mmap(nullptr, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (mapped == MAP_FAILED) {
+        printf("Unable to map asset pack %s!\n", path.c_str());
+        ::close(file);
+        return false;
+    }
+
+    mFile = file;
+    mSize = (size_t) info.st_size;
+    mData = (const uint8_t *) mapped;
+#endif
+
+    if (mData == nullptr || mSize < sizeof(AssetPackHeader)) {
+        printf("Asset pack %s is truncated!\n", path.c_str());
+        close();
+        return false;
+    }
+
+    const AssetPackHeader *header = (const AssetPackHeader *) mData;
+    if (memcmp(header->magic, ASSET_PACK_MAGIC, sizeof(ASSET_PACK_MAGIC)) != 0 ||
+        header->version != ASSET_PACK_VERSION ||
+        sizeof(AssetPackHeader) + header->entryCount * sizeof(AssetPackEntry) > mSize) {
+        printf("Asset pack %s is invalid or out of date!\n", path.c_str());
+        close();
+        return false;
+    }
+
+    mEntries = (const AssetPackEntry *) (mData + sizeof(AssetPackHeader));
+    mEntryCount = header->entryCount;
+
+    for (uint32_t i = 0; i < mEntryCount; i++) {
+        if (mEntries[i].offset > mSize || mEntries[i].size > mSize - mEntries[i].offset) {
+            printf("Asset pack %s has an out of range entry!\n", path.c_str());
+            close();
+            return false;
+        }
+
+        if (mEntries[i].type == ASSET_TYPE_IMAGE && !isImageSizeValid(mEntries[i])) {
+            printf("Asset pack %s has an image entry of the wrong size!\n", path.c_str());
+            close();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void AssetPack::close() {
+#if defined(_WIN32)
+    if (mData != nullptr) {
+        UnmapViewOfFile(mData);
+    }
+    if (mMapping != nullptr) {
+        CloseHandle((HANDLE) mMapping);
+        mMapping = nullptr;
+    }
+    if (mFile != nullptr) {
+        CloseHandle((HANDLE) mFile);
+        mFile = nullptr;
+    }
+#else
+    if (mData != nullptr) {
+        munmap((void *) mData, mSize);
+    }
+    if (mFile >= 0) {
+        ::close(mFile);
+        mFile = -1;
+    }
+#endif
+
+    mData = nullptr;
+    mSize = 0;
+    mEntries = nullptr;
+    mEntryCount = 0;
+}
+
+bool AssetPack::isOpen() {
+    return mData != nullptr;
+}
+
+const AssetPackEntry *AssetPack::find(std::string name) {
+    for (uint32_t i = 0; i < mEntryCount; i++) {
+        if (strncmp(mEntries[i].name, name.c_str(), ASSET_NAME_LENGTH) == 0) {
+            return &mEntries[i];
+        }
+    }
+
+    return nullptr;
+}
+
+const uint8_t *AssetPack::getData(const AssetPackEntry *entry) {
+    return mData + entry->offset;
+}
+
+const uint8_t *AssetPack::getPixels(const AssetPackEntry *entry, std::vector<uint8_t> *scratch) {
+    const uint8_t *data = getData(entry);
+    if (!(entry->flags & ASSET_FLAG_LZ4)) {
+        return data;
+    }
+
+    scratch->resize(entry->rawSize);
+    int size = lz4DecompressBlock(data, (int) entry->size, scratch->data(), (int) scratch->size());
+    return size == (int) entry->rawSize ? scratch->data() : nullptr;
+}
@@ -0,0 +1,79 @@
+#ifndef CIV_ASSETPACK_H
+#define CIV_ASSETPACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// On-disk layout of a pack built by civ_pack:
+//
+//   AssetPackHeader
+//   AssetPackEntry[entryCount]
+//   entry payloads, each aligned to ASSET_PACK_ALIGNMENT
+//
+// Images are stored as pre-decoded, tightly packed RGBA32 rows (optionally
+// LZ4-compressed) so the runtime can hand the mapped bytes straight to
+// SDL_UpdateTexture. Fonts are stored verbatim.
+
+const char ASSET_PACK_MAGIC[8] = {'C', 'I', 'V', 'P', 'A', 'C', 'K', '\0'};
+const uint32_t ASSET_PACK_VERSION = 1;
+const uint64_t ASSET_PACK_ALIGNMENT = 64;
+const int ASSET_NAME_LENGTH = 112;
+
+const uint32_t ASSET_TYPE_IMAGE = 0;
+const uint32_t ASSET_TYPE_FONT = 1;
+
+const uint32_t ASSET_FLAG_LZ4 = 1;
+
+struct AssetPackHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t entryCount;
+};
+
+struct AssetPackEntry {
+    char name[ASSET_NAME_LENGTH];
+    uint32_t type;
+    uint32_t flags;
+    uint32_t width;
+    uint32_t height;
+    uint64_t offset;
+    uint64_t size;
+    uint64_t rawSize;
+};
+
+class AssetPack {
+public:
+    AssetPack();
+
+    ~AssetPack();
+
+    bool open(std::string path);
+
+    void close();
+
+    bool isOpen();
+
+    const AssetPackEntry *find(std::string name);
+
+    const uint8_t *getData(const AssetPackEntry *entry);
+
+    // RGBA32 rows of an image entry, straight from the mapping or
+    // decompressed into scratch; nullptr if the payload is corrupt
+    const uint8_t *getPixels(const AssetPackEntry *entry, std::vector<uint8_t> *scratch);
+
+private:
+    const uint8_t *mData;
+    size_t mSize;
+    const AssetPackEntry *mEntries;
+    uint32_t mEntryCount;
+#if defined(_WIN32)
+    void *mFile;
+    void *mMapping;
+#else
+    int mFile;
+#endif
+};
+
+#endif
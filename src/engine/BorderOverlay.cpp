@@ -0,0 +1,80 @@
+#include "BorderOverlay.h"
+#include "RenderStats.h"
+#include "constants.h"
+
+static const SDL_Color PLAYER_COLOURS[BORDER_COLOURS] = {
+        {0xD0, 0x20, 0x20, 0xFF},
+        {0x20, 0x50, 0xD0, 0xFF},
+        {0xF0, 0xE0, 0x30, 0xFF},
+        {0x80, 0x30, 0xC0, 0xFF},
+        {0xF0, 0xF0, 0xF0, 0xFF},
+        {0xF0, 0x80, 0x20, 0xFF},
+        {0x20, 0xC0, 0xC0, 0xFF},
+        {0x20, 0x20, 0x20, 0xFF}
+};
+
+BorderOverlay::BorderOverlay(SDL_Renderer *renderer, const InfluenceMap *influence) :
+        renderer(renderer),
+        influence(influence),
+        builtVersion(0),
+        built(false) {
+
+}
+
+void BorderOverlay::render() {
+    if (!built || builtVersion != influence->getVersion()) {
+        rebuild();
+    }
+
+    RenderStats &stats = RenderStats::instance();
+    for (int colour = 0; colour < BORDER_COLOURS; colour++) {
+        if (edges[colour].empty()) {
+            continue;
+        }
+
+        const SDL_Color &c = PLAYER_COLOURS[colour];
+        SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
+        SDL_RenderFillRects(renderer, edges[colour].data(), (int) edges[colour].size());
+        stats.countDrawCall();
+    }
+}
+
+void BorderOverlay::rebuild() {
+    for (auto &list : edges) {
+        list.clear();
+    }
+
+    int width = influence->getWidth();
+    int height = influence->getHeight();
+    const uint8_t *owners = influence->getOwners();
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t owner = owners[y * width + x];
+            if (!influence->isBorder(x, y)) {
+                continue;
+            }
+
+            // The ground of each sprite is the TILE_SIZE square below its top overhang
+            int left = x * TILE_WIDTH;
+            int top = y * TILE_SIZE;
+            std::vector<SDL_Rect> &list = edges[owner % BORDER_COLOURS];
+
+            if (x > 0 && owners[y * width + x - 1] != owner) {
+                list.push_back(SDL_Rect{left, top, BORDER_THICKNESS, TILE_SIZE});
+            }
+            if (x < width - 1 && owners[y * width + x + 1] != owner) {
+                list.push_back(SDL_Rect{left + TILE_WIDTH - BORDER_THICKNESS, top, BORDER_THICKNESS, TILE_SIZE});
+            }
+            if (y > 0 && owners[(y - 1) * width + x] != owner) {
+                list.push_back(SDL_Rect{left, top, TILE_WIDTH, BORDER_THICKNESS});
+            }
+            if (y < height - 1 && owners[(y + 1) * width + x] != owner) {
+                list.push_back(SDL_Rect{left, top + TILE_SIZE - BORDER_THICKNESS, TILE_WIDTH, BORDER_THICKNESS});
+            }
+        }
+    }
+
+    builtVersion = influence->getVersion();
+    built = true;
+}
@@ -0,0 +1,31 @@
+#ifndef CIV_BORDEROVERLAY_H
+#define CIV_BORDEROVERLAY_H
+
+#include <SDL.h>
+#include <vector>
+
+#include "../world/InfluenceMap.h"
+
+const int BORDER_COLOURS = 8;
+const int BORDER_THICKNESS = 8;
+
+// Draws territory borders straight from the influence map's owner array.
+// Edge rectangles are rebuilt only when the map's version changes and are
+// then drawn with one fill call per player colour.
+class BorderOverlay {
+public:
+    BorderOverlay(SDL_Renderer *renderer, const InfluenceMap *influence);
+
+    void render();
+
+private:
+    void rebuild();
+
+    SDL_Renderer *renderer;
+    const InfluenceMap *influence;
+    uint32_t builtVersion;
+    bool built;
+    std::vector<SDL_Rect> edges[BORDER_COLOURS];
+};
+
+#endif
@@ -1,9 +1,9 @@
-#include <iostream>
-using namespace std;
+#include <cstdlib>
 
 #include "Button.h"
 #include "constants.h"
 #include "Tile.h"
+#include "TilePicker.h"
 
 Button::Button(SDL_Renderer *renderer,
                Texture *texture,
@@ -17,46 +17,40 @@ Button::Button(SDL_Renderer *renderer,
     position.y = y;
 }
 
-void Button::handleEvent(SDL_Event *e, std::vector<Tile> *tiles, SDL_Rect tileClips[]) {
+bool Button::handleEvent(SDL_Event *e, GameMap *map, std::vector<Tile> *tiles, SDL_Rect tileClips[], SDL_Rect iconClips[]) {
     if (e->type == SDL_MOUSEBUTTONUP) {
-        int x, y;
-        SDL_GetMouseState(&x, &y);
+        SDL_Point point = windowToRenderer(renderer, e->button.x, e->button.y);
 
-        SDL_Rect iconClip;
-        iconClip.x = 2302; //7 + TILE_WIDTH * 8 + ICON_WIDTH * 0;
-        iconClip.y = 2; //ICON_HEIGHT * 0;
-        iconClip.w = ICON_WIDTH;
-        iconClip.h = ICON_HEIGHT;
+        if (point.x >= position.x &&
+            point.x < position.x + clip.w &&
+            point.y >= position.y &&
+            point.y < position.y + clip.h) {
+            map->generate((unsigned) rand()); // NOLINT(cert-msc30-c, cert-msc50-cpp)
 
-        if (x * 2 >= position.x &&
-            x * 2 <= position.x + BUTTON_WIDTH &&
-            y * 2 >= position.y &&
-            y * 2 <= position.y + BUTTON_HEIGHT) {
             tiles->clear();
-            for (int row = 0; row < NUM_ROWS; row++) {
-                for (int col = 0; col < NUM_COLS; col++) {
-                    int randClip = rand() % 32; // NOLINT(cert-msc30-c, cert-msc50-cpp)
-                    Tile tile = Tile(renderer,
-                                     texture,
-                                     col * TILE_WIDTH,
-                                     row * TILE_SIZE - TILE_SIZE / 2,
-                                     tileClips[randClip]);
-                    tile.addLayer(TileLayer(renderer,
-                                            texture,
-                                            col * TILE_WIDTH,
-                                            row * TILE_SIZE - TILE_SIZE / 2,
-                                            iconClip,
-                                            0));
-
-                    tiles->emplace_back(tile);
+            tiles->reserve((size_t) map->getWidth() * map->getHeight());
+            for (int row = 0; row < map->getHeight(); row++) {
+                for (int col = 0; col < map->getWidth(); col++) {
+                    tiles->emplace_back(renderer,
+                                        texture,
+                                        col * TILE_WIDTH,
+                                        row * TILE_SIZE - TILE_SIZE / 2,
+                                        tileClips[map->getTerrain(col, row)],
+                                        map->getTerrain(col, row));
+                    tiles->back().addLayer(TileLayer(renderer,
+                                                     texture,
+                                                     col * TILE_WIDTH,
+                                                     row * TILE_SIZE - TILE_SIZE / 2,
+                                                     iconClips[FOOD_ICON],
+                                                     0));
                 }
             }
 
-            for (auto t : *tiles) {
-                cout << t.getFood() << endl;
-            }
+            return true;
         }
     }
+
+    return false;
 }
 
 void Button::render() {
@@ -4,6 +4,7 @@
 #include <SDL.h>
 #include "Texture.h"
 #include "Tile.h"
+#include "../world/GameMap.h"
 
 class Button {
 public:
@@ -13,7 +14,8 @@ public:
            int y,
            SDL_Rect clip);
 
-    void handleEvent(SDL_Event *e, std::vector<Tile> *tiles, SDL_Rect tileClips[]);
+    // Returns true if the click regenerated the map
+    bool handleEvent(SDL_Event *e, GameMap *map, std::vector<Tile> *tiles, SDL_Rect tileClips[], SDL_Rect iconClips[]);
 
     void render();
 
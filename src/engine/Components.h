@@ -0,0 +1,92 @@
+#ifndef CIV_COMPONENTS_H
+#define CIV_COMPONENTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Plain data components stored in the entity manager's archetype columns.
+// Components are copied around with memcpy when an entity changes archetype,
+// so they must stay trivially copyable.
+
+struct Position {
+    int x;
+    int y;
+};
+
+struct Owner {
+    int player;
+};
+
+struct Movement {
+    int moves;
+    int maxMoves;
+};
+
+struct Health {
+    int hp;
+    int maxHp;
+};
+
+struct Sprite {
+    int clip;
+    int zIndex;
+};
+
+typedef uint32_t ComponentMask;
+
+const int NUM_COMPONENT_TYPES = 5;
+
+const size_t COMPONENT_SIZES[NUM_COMPONENT_TYPES] = {
+        sizeof(Position),
+        sizeof(Owner),
+        sizeof(Movement),
+        sizeof(Health),
+        sizeof(Sprite)
+};
+
+template<typename T>
+struct ComponentId;
+
+template<>
+struct ComponentId<Position> {
+    static const int value = 0;
+};
+
+template<>
+struct ComponentId<Owner> {
+    static const int value = 1;
+};
+
+template<>
+struct ComponentId<Movement> {
+    static const int value = 2;
+};
+
+template<>
+struct ComponentId<Health> {
+    static const int value = 3;
+};
+
+template<>
+struct ComponentId<Sprite> {
+    static const int value = 4;
+};
+
+template<typename T>
+ComponentMask componentBit() {
+    static_assert(std::is_trivially_copyable<T>::value, "Components must be trivially copyable");
+    return 1u << ComponentId<T>::value;
+}
+
+template<typename... T>
+ComponentMask componentMask() {
+    ComponentMask mask = 0;
+    ComponentMask bits[] = {0u, componentBit<T>()...};
+    for (ComponentMask bit : bits) {
+        mask |= bit;
+    }
+    return mask;
+}
+
+#endif
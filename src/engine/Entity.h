@@ -0,0 +1,24 @@
+#ifndef CIV_ENTITY_H
+#define CIV_ENTITY_H
+
+#include <cstdint>
+
+// Stable handle to an entity. The index addresses a slot in the entity
+// manager and the generation is bumped whenever the slot is reused, so a
+// handle to a destroyed entity never aliases a newer one.
+struct Entity {
+    uint32_t index;
+    uint32_t generation;
+
+    bool operator==(const Entity &other) const {
+        return index == other.index && generation == other.generation;
+    }
+
+    bool operator!=(const Entity &other) const {
+        return !(*this == other);
+    }
+};
+
+const Entity NULL_ENTITY = {UINT32_MAX, 0};
+
+#endif
@@ -0,0 +1,228 @@
+#include <cstring>
+#include "EntityManager.h"
+
+static const size_t COLUMN_ALIGNMENT = 16;
+
+static size_t alignColumn(size_t offset) {
+    return (offset + COLUMN_ALIGNMENT - 1) & ~(COLUMN_ALIGNMENT - 1);
+}
+
+Archetype::Archetype(ComponentMask mask) :
+        mask(mask),
+        count(0) {
+    size_t rowBytes = sizeof(Entity);
+    int columns = 1;
+    for (int id = 0; id < NUM_COMPONENT_TYPES; id++) {
+        if (mask & (1u << id)) {
+            rowBytes += COMPONENT_SIZES[id];
+            columns++;
+        }
+    }
+
+    capacity = (uint32_t) ((CHUNK_BYTES - columns * COLUMN_ALIGNMENT) / rowBytes);
+
+    size_t offset = alignColumn(capacity * sizeof(Entity));
+    for (int id = 0; id < NUM_COMPONENT_TYPES; id++) {
+        columnOffsets[id] = 0;
+        if (mask & (1u << id)) {
+            columnOffsets[id] = offset;
+            offset = alignColumn(offset + capacity * COMPONENT_SIZES[id]);
+        }
+    }
+}
+
+ComponentMask Archetype::getMask() const {
+    return mask;
+}
+
+uint32_t Archetype::getCapacity() const {
+    return capacity;
+}
+
+size_t Archetype::getChunkCount() const {
+    return chunks.size();
+}
+
+uint32_t Archetype::getCount(size_t chunk) const {
+    return chunks[chunk].count;
+}
+
+size_t Archetype::size() const {
+    return count;
+}
+
+Entity *Archetype::getEntities(size_t chunk) {
+    return (Entity *) chunks[chunk].data.get();
+}
+
+void *Archetype::getColumn(size_t chunk, int componentId) {
+    if (!(mask & (1u << componentId))) {
+        return nullptr;
+    }
+
+    return chunks[chunk].data.get() + columnOffsets[componentId];
+}
+
+void Archetype::push(Entity entity, uint32_t *chunk, uint32_t *row) {
+    if (chunks.empty() || chunks.back().count == capacity) {
+        Chunk newChunk;
+        newChunk.data.reset(new uint8_t[CHUNK_BYTES]);
+        newChunk.count = 0;
+        chunks.push_back(std::move(newChunk));
+    }
+
+    *chunk = (uint32_t) (chunks.size() - 1);
+    *row = chunks.back().count++;
+    getEntities(*chunk)[*row] = entity;
+    count++;
+}
+
+Entity Archetype::erase(uint32_t chunk, uint32_t row) {
+    uint32_t lastChunk = (uint32_t) (chunks.size() - 1);
+    uint32_t lastRow = chunks[lastChunk].count - 1;
+    Entity moved = NULL_ENTITY;
+
+    if (chunk != lastChunk || row != lastRow) {
+        moved = getEntities(lastChunk)[lastRow];
+        getEntities(chunk)[row] = moved;
+
+        for (int id = 0; id < NUM_COMPONENT_TYPES; id++) {
+            if (mask & (1u << id)) {
+                size_t size = COMPONENT_SIZES[id];
+                memcpy(chunks[chunk].data.get() + columnOffsets[id] + row * size,
+                       chunks[lastChunk].data.get() + columnOffsets[id] + lastRow * size,
+                       size);
+            }
+        }
+    }
+
+    if (--chunks[lastChunk].count == 0) {
+        chunks.pop_back();
+    }
+    count--;
+
+    return moved;
+}
+
+EntityManager::EntityManager() :
+        count(0) {
+
+}
+
+Entity EntityManager::create(ComponentMask mask) {
+    uint32_t index;
+    if (freeIndices.empty()) {
+        index = (uint32_t) records.size();
+        records.push_back(EntityRecord{nullptr, 0, 0, 0});
+    } else {
+        index = freeIndices.back();
+        freeIndices.pop_back();
+    }
+
+    EntityRecord &record = records[index];
+    Entity entity = {index, record.generation};
+
+    record.archetype = getArchetype(mask);
+    record.archetype->push(entity, &record.chunk, &record.row);
+
+    Archetype *archetype = record.archetype;
+    for (int id = 0; id < NUM_COMPONENT_TYPES; id++) {
+        void *column = archetype->getColumn(record.chunk, id);
+        if (column != nullptr) {
+            memset((uint8_t *) column + record.row * COMPONENT_SIZES[id], 0, COMPONENT_SIZES[id]);
+        }
+    }
+
+    count++;
+    return entity;
+}
+
+void EntityManager::destroy(Entity entity) {
+    if (!isAlive(entity)) {
+        return;
+    }
+
+    EntityRecord &record = records[entity.index];
+    eraseRecord(record.archetype, record.chunk, record.row);
+
+    record.archetype = nullptr;
+    record.generation++;
+    freeIndices.push_back(entity.index);
+    count--;
+}
+
+bool EntityManager::isAlive(Entity entity) const {
+    return entity.index < records.size() &&
+           records[entity.index].generation == entity.generation &&
+           records[entity.index].archetype != nullptr;
+}
+
+size_t EntityManager::size() const {
+    return count;
+}
+
+Archetype *EntityManager::getArchetype(ComponentMask mask) {
+    auto it = archetypeIndex.find(mask);
+    if (it != archetypeIndex.end()) {
+        return it->second;
+    }
+
+    archetypes.emplace_back(new Archetype(mask));
+    Archetype *archetype = archetypes.back().get();
+    archetypeIndex[mask] = archetype;
+
+    return archetype;
+}
+
+void EntityManager::moveToArchetype(Entity entity, ComponentMask mask) {
+    EntityRecord &record = records[entity.index];
+    Archetype *from = record.archetype;
+    Archetype *to = getArchetype(mask);
+
+    uint32_t chunk;
+    uint32_t row;
+    to->push(entity, &chunk, &row);
+
+    for (int id = 0; id < NUM_COMPONENT_TYPES; id++) {
+        uint8_t *dst = (uint8_t *) to->getColumn(chunk, id);
+        if (dst == nullptr) {
+            continue;
+        }
+
+        dst += row * COMPONENT_SIZES[id];
+        uint8_t *src = (uint8_t *) from->getColumn(record.chunk, id);
+        if (src != nullptr) {
+            memcpy(dst, src + record.row * COMPONENT_SIZES[id], COMPONENT_SIZES[id]);
+        } else {
+            memset(dst, 0, COMPONENT_SIZES[id]);
+        }
+    }
+
+    eraseRecord(from, record.chunk, record.row);
+
+    record.archetype = to;
+    record.chunk = chunk;
+    record.row = row;
+}
+
+void EntityManager::eraseRecord(Archetype *archetype, uint32_t chunk, uint32_t row) {
+    Entity moved = archetype->erase(chunk, row);
+    if (moved != NULL_ENTITY) {
+        records[moved.index].chunk = chunk;
+        records[moved.index].row = row;
+    }
+}
+
+void *EntityManager::getComponent(Entity entity, int componentId) {
+    if (!isAlive(entity)) {
+        return nullptr;
+    }
+
+    EntityRecord &record = records[entity.index];
+    uint8_t *column = (uint8_t *) record.archetype->getColumn(record.chunk, componentId);
+    if (column == nullptr) {
+        return nullptr;
+    }
+
+    return column + record.row * COMPONENT_SIZES[componentId];
+}
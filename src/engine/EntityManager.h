@@ -0,0 +1,226 @@
+#ifndef CIV_ENTITYMANAGER_H
+#define CIV_ENTITYMANAGER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Components.h"
+#include "Entity.h"
+#include "FrameArena.h"
+#include "WorkerPool.h"
+
+const size_t CHUNK_BYTES = 16 * 1024;
+
+// Below this many chunks per worker, waking threads costs more than it saves
+const size_t MIN_CHUNKS_PER_THREAD = 8;
+
+// All entities that share exactly the same set of components. Each component
+// is stored as a contiguous column inside fixed-size chunks, and every chunk
+// except the last is kept full, so iterating an archetype is a linear walk
+// over densely packed arrays.
+class Archetype {
+public:
+    explicit Archetype(ComponentMask mask);
+
+    ComponentMask getMask() const;
+
+    uint32_t getCapacity() const;
+
+    size_t getChunkCount() const;
+
+    uint32_t getCount(size_t chunk) const;
+
+    size_t size() const;
+
+    Entity *getEntities(size_t chunk);
+
+    void *getColumn(size_t chunk, int componentId);
+
+    template<typename T>
+    T *getColumn(size_t chunk) {
+        return (T *) getColumn(chunk, ComponentId<T>::value);
+    }
+
+    void push(Entity entity, uint32_t *chunk, uint32_t *row);
+
+    // Fills the hole with the last row and returns the entity that moved
+    // into it, or NULL_ENTITY if the erased row was the last one.
+    Entity erase(uint32_t chunk, uint32_t row);
+
+private:
+    struct Chunk {
+        std::unique_ptr<uint8_t[]> data;
+        uint32_t count;
+    };
+
+    ComponentMask mask;
+    uint32_t capacity;
+    size_t columnOffsets[NUM_COMPONENT_TYPES];
+    std::vector<Chunk> chunks;
+    size_t count;
+};
+
+class EntityManager {
+public:
+    EntityManager();
+
+    Entity create(ComponentMask mask);
+
+    template<typename... T>
+    Entity createWith(const T &... components) {
+        Entity entity = create(componentMask<T...>());
+        int unused[] = {0, (*get<T>(entity) = components, 0)...};
+        (void) unused;
+        return entity;
+    }
+
+    void destroy(Entity entity);
+
+    bool isAlive(Entity entity) const;
+
+    size_t size() const;
+
+    template<typename T>
+    T *get(Entity entity) {
+        return (T *) getComponent(entity, ComponentId<T>::value);
+    }
+
+    template<typename T>
+    bool has(Entity entity) {
+        return get<T>(entity) != nullptr;
+    }
+
+    template<typename T>
+    void add(Entity entity, const T &component) {
+        if (!isAlive(entity)) {
+            return;
+        }
+
+        ComponentMask mask = records[entity.index].archetype->getMask();
+        if (!(mask & componentBit<T>())) {
+            moveToArchetype(entity, mask | componentBit<T>());
+        }
+        *get<T>(entity) = component;
+    }
+
+    template<typename T>
+    void remove(Entity entity) {
+        if (!isAlive(entity)) {
+            return;
+        }
+
+        ComponentMask mask = records[entity.index].archetype->getMask();
+        if (mask & componentBit<T>()) {
+            moveToArchetype(entity, mask & ~componentBit<T>());
+        }
+    }
+
+    // Calls fn(count, entities, columns...) once per chunk holding all of T.
+    // Entities must not be created, destroyed or change components while
+    // iterating.
+    template<typename... T, typename F>
+    void forEachChunk(F fn) {
+        ComponentMask required = componentMask<T...>();
+
+        for (auto &archetype : archetypes) {
+            if ((archetype->getMask() & required) != required) {
+                continue;
+            }
+
+            for (size_t chunk = 0; chunk < archetype->getChunkCount(); chunk++) {
+                fn(archetype->getCount(chunk),
+                   archetype->getEntities(chunk),
+                   archetype->template getColumn<T>(chunk)...);
+            }
+        }
+    }
+
+    // Calls fn(entity, components...) for every entity holding all of T.
+    template<typename... T, typename F>
+    void forEach(F fn) {
+        forEachChunk<T...>([&fn](uint32_t count, Entity *entities, T *... columns) {
+            for (uint32_t i = 0; i < count; i++) {
+                fn(entities[i], columns[i]...);
+            }
+        });
+    }
+
+    // Same as forEach, but chunks are spread across worker threads. fn must
+    // only touch the components it is handed.
+    template<typename... T, typename F>
+    void parallelForEach(F fn, unsigned threadCount = 0) {
+        typedef std::pair<Archetype *, size_t> WorkItem;
+
+        // The chunk list is rebuilt every call, so keep it off the heap
+        ComponentMask required = componentMask<T...>();
+        FrameArena &arena = FrameArena::local();
+        ArenaScope scratch(arena);
+        ArenaVector<WorkItem> work{ArenaAllocator<WorkItem>(&arena)};
+
+        for (auto &archetype : archetypes) {
+            if ((archetype->getMask() & required) == required) {
+                for (size_t chunk = 0; chunk < archetype->getChunkCount(); chunk++) {
+                    work.emplace_back(archetype.get(), chunk);
+                }
+            }
+        }
+
+        if (threadCount == 0) {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threadCount = (unsigned) std::min<size_t>(threadCount, work.size() / MIN_CHUNKS_PER_THREAD);
+
+        std::atomic<size_t> next(0);
+        auto worker = [&]() {
+            for (size_t i = next++; i < work.size(); i = next++) {
+                Archetype *archetype = work[i].first;
+                size_t chunk = work[i].second;
+                uint32_t count = archetype->getCount(chunk);
+                Entity *entities = archetype->getEntities(chunk);
+
+                runChunk<T...>(fn, count, entities, archetype->template getColumn<T>(chunk)...);
+            }
+        };
+
+        // Workers stay alive between calls, so a turn starts no threads
+        WorkerPool::instance().run(threadCount,
+                                   [](void *context) { (*(decltype(worker) *) context)(); },
+                                   &worker);
+    }
+
+private:
+    struct EntityRecord {
+        Archetype *archetype;
+        uint32_t chunk;
+        uint32_t row;
+        uint32_t generation;
+    };
+
+    template<typename... T, typename F>
+    static void runChunk(F &fn, uint32_t count, Entity *entities, T *... columns) {
+        for (uint32_t i = 0; i < count; i++) {
+            fn(entities[i], columns[i]...);
+        }
+    }
+
+    Archetype *getArchetype(ComponentMask mask);
+
+    void moveToArchetype(Entity entity, ComponentMask mask);
+
+    void eraseRecord(Archetype *archetype, uint32_t chunk, uint32_t row);
+
+    void *getComponent(Entity entity, int componentId);
+
+    std::vector<EntityRecord> records;
+    std::vector<uint32_t> freeIndices;
+    std::vector<std::unique_ptr<Archetype>> archetypes;
+    std::unordered_map<ComponentMask, Archetype *> archetypeIndex;
+    size_t count;
+};
+
+#endif
@@ -0,0 +1,109 @@
+#include <cstdarg>
+#include <cstdio>
+#include "FrameArena.h"
+
+FrameArena::FrameArena(size_t capacity) :
+        buffer(new uint8_t[capacity]),
+        capacity(capacity),
+        offset(0),
+        overflowBytes(0),
+        highWater(0),
+        overflowCount(0) {
+
+}
+
+FrameArena &FrameArena::local() {
+    static thread_local FrameArena arena;
+    return arena;
+}
+
+void *FrameArena::allocate(size_t size, size_t alignment) {
+    size_t start = (offset + alignment - 1) & ~(alignment - 1);
+
+    if (start + size <= capacity) {
+        offset = start + size;
+        if (offset + overflowBytes > highWater) {
+            highWater = offset + overflowBytes;
+        }
+        return buffer.get() + start;
+    }
+
+    // Out of room this frame: fall back to the heap and remember how much
+    // was needed so reset() can grow the buffer
+    overflow.emplace_back(new uint8_t[size + alignment]);
+    overflowBytes += size + alignment;
+    overflowCount++;
+    if (offset + overflowBytes > highWater) {
+        highWater = offset + overflowBytes;
+    }
+
+    uintptr_t address = (uintptr_t) overflow.back().get();
+    return (void *) ((address + alignment - 1) & ~(uintptr_t) (alignment - 1));
+}
+
+char *FrameArena::format(const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    va_list measure;
+    va_copy(measure, args);
+    int length = vsnprintf(nullptr, 0, fmt, measure);
+    va_end(measure);
+
+    if (length < 0) {
+        va_end(args);
+        return nullptr;
+    }
+
+    char *text = (char *) allocate((size_t) length + 1, 1);
+    vsnprintf(text, (size_t) length + 1, fmt, args);
+    va_end(args);
+
+    return text;
+}
+
+FrameArena::Marker FrameArena::mark() {
+    return Marker{offset, overflow.size(), overflowBytes};
+}
+
+void FrameArena::rewind(Marker marker) {
+    offset = marker.offset;
+    overflow.resize(marker.overflowBlocks);
+    overflowBytes = marker.overflowBytes;
+}
+
+void FrameArena::reset() {
+    if (highWater > capacity) {
+        capacity = highWater + highWater / 2;
+        buffer.reset(new uint8_t[capacity]);
+    }
+
+    overflow.clear();
+    offset = 0;
+    overflowBytes = 0;
+}
+
+size_t FrameArena::getUsed() {
+    return offset + overflowBytes;
+}
+
+size_t FrameArena::getCapacity() {
+    return capacity;
+}
+
+size_t FrameArena::getHighWater() {
+    return highWater;
+}
+
+size_t FrameArena::getOverflowCount() {
+    return overflowCount;
+}
+
+ArenaScope::ArenaScope(FrameArena &arena) :
+        arena(arena),
+        marker(arena.mark()) {
+
+}
+
+ArenaScope::~ArenaScope() {
+    arena.rewind(marker);
+}
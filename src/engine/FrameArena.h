@@ -0,0 +1,120 @@
+#ifndef CIV_FRAMEARENA_H
+#define CIV_FRAMEARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+const size_t FRAME_ARENA_DEFAULT_BYTES = 256 * 1024;
+
+// Linear allocator for data that only lives until the end of a frame (draw
+// lists, formatted strings, scratch buffers). Allocation is a pointer bump
+// and nothing is freed individually; reset() rewinds the whole arena at the
+// end of the frame. If a frame outgrows the buffer, the excess is served
+// from the heap and the buffer is grown to the high-water mark on the next
+// reset, so steady-state frames never touch the general-purpose heap.
+class FrameArena {
+public:
+    struct Marker {
+        size_t offset;
+        size_t overflowBlocks;
+        size_t overflowBytes;
+    };
+
+    explicit FrameArena(size_t capacity = FRAME_ARENA_DEFAULT_BYTES);
+
+    // Arena owned by the calling thread
+    static FrameArena &local();
+
+    void *allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    template<typename T>
+    T *allocateArray(size_t count) {
+        return (T *) allocate(sizeof(T) * count, alignof(T));
+    }
+
+    // printf into arena memory; the string is valid until reset()
+    char *format(const char *fmt, ...);
+
+    Marker mark();
+
+    // Releases everything allocated since the marker was taken
+    void rewind(Marker marker);
+
+    void reset();
+
+    size_t getUsed();
+
+    size_t getCapacity();
+
+    size_t getHighWater();
+
+    size_t getOverflowCount();
+
+private:
+    std::unique_ptr<uint8_t[]> buffer;
+    size_t capacity;
+    size_t offset;
+    size_t overflowBytes;
+    size_t highWater;
+    size_t overflowCount;
+    std::vector<std::unique_ptr<uint8_t[]>> overflow;
+};
+
+// Restores the arena to where it was when the scope was entered
+class ArenaScope {
+public:
+    explicit ArenaScope(FrameArena &arena);
+
+    ~ArenaScope();
+
+private:
+    FrameArena &arena;
+    FrameArena::Marker marker;
+};
+
+// STL allocator over a FrameArena. deallocate() is a no-op; memory comes
+// back when the arena is reset, so containers using it must not outlive
+// the frame.
+template<typename T>
+class ArenaAllocator {
+public:
+    typedef T value_type;
+
+    explicit ArenaAllocator(FrameArena *arena) :
+            arena(arena) {
+
+    }
+
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) :
+            arena(other.arena) {
+
+    }
+
+    T *allocate(size_t count) {
+        return arena->allocateArray<T>(count);
+    }
+
+    void deallocate(T *, size_t) {
+
+    }
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U> &other) const {
+        return arena == other.arena;
+    }
+
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U> &other) const {
+        return arena != other.arena;
+    }
+
+    FrameArena *arena;
+};
+
+template<typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif
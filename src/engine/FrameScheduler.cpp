@@ -0,0 +1,113 @@
+#include <cstdio>
+#include <cstdint>
+#include "FrameScheduler.h"
+
+Uint32 FrameScheduler::timerEventType = (Uint32) -1;
+
+FrameScheduler::FrameScheduler() :
+        continuous(false),
+        dirty(true),
+        animations(0),
+        nextTimerId(1) {
+    if (timerEventType == (Uint32) -1) {
+        timerEventType = SDL_RegisterEvents(1);
+    }
+}
+
+FrameScheduler::~FrameScheduler() {
+    for (auto &timer : timers) {
+        SDL_RemoveTimer(timer.second.sdlTimer);
+    }
+}
+
+void FrameScheduler::setContinuous(bool c) {
+    this->continuous = c;
+}
+
+void FrameScheduler::requestRedraw() {
+    dirty = true;
+}
+
+void FrameScheduler::beginAnimation() {
+    animations++;
+}
+
+void FrameScheduler::endAnimation() {
+    if (animations > 0) {
+        animations--;
+    }
+}
+
+bool FrameScheduler::isIdle() {
+    return !continuous && !dirty && animations == 0;
+}
+
+bool FrameScheduler::waitEvent(SDL_Event *e) {
+    if (isIdle()) {
+        return SDL_WaitEventTimeout(e, IDLE_WAIT_MS) != 0;
+    }
+
+    return SDL_PollEvent(e) != 0;
+}
+
+bool FrameScheduler::handleEvent(SDL_Event *e) {
+    if (e->type == timerEventType) {
+        auto it = timers.find(e->user.code);
+
+        // The timer may have been removed after SDL already queued its event
+        if (it != timers.end() && !it->second.callback()) {
+            removeTimer(e->user.code);
+        }
+
+        return true;
+    }
+
+    // Pointer movement alone changes nothing on screen; subsystems that
+    // react to hover request their own redraw
+    if (e->type != SDL_MOUSEMOTION) {
+        dirty = true;
+    }
+
+    return false;
+}
+
+bool FrameScheduler::needsFrame() {
+    return !isIdle();
+}
+
+void FrameScheduler::frameRendered() {
+    dirty = false;
+}
+
+int FrameScheduler::addTimer(Uint32 intervalMs, std::function<bool()> callback) {
+    int id = nextTimerId++;
+
+    ScheduledTimer timer;
+    timer.callback = callback;
+    timer.sdlTimer = SDL_AddTimer(intervalMs, pushTimerEvent, (void *) (intptr_t) id);
+    if (timer.sdlTimer == 0) {
+        printf("Unable to add timer! SDL Error: %s\n", SDL_GetError());
+        return 0;
+    }
+
+    timers[id] = timer;
+    return id;
+}
+
+void FrameScheduler::removeTimer(int id) {
+    auto it = timers.find(id);
+    if (it != timers.end()) {
+        SDL_RemoveTimer(it->second.sdlTimer);
+        timers.erase(it);
+    }
+}
+
+Uint32 FrameScheduler::pushTimerEvent(Uint32 interval, void *param) {
+    SDL_Event event;
+    SDL_memset(&event, 0, sizeof(event));
+    event.type = timerEventType;
+    event.user.code = (Sint32) (intptr_t) param;
+    SDL_PushEvent(&event);
+
+    return interval;
+}
@@ -0,0 +1,65 @@
+#ifndef CIV_FRAMESCHEDULER_H
+#define CIV_FRAMESCHEDULER_H
+
+#include <SDL.h>
+#include <functional>
+#include <unordered_map>
+
+// Longest the loop sleeps without any event, as a safety net
+const int IDLE_WAIT_MS = 1000;
+
+// Decides when the main loop needs to render. Nothing is drawn unless a
+// redraw was requested, an animation is running or an input event arrived;
+// otherwise the loop blocks in SDL_WaitEventTimeout. Subsystems that need to
+// wake the loop later register a timer, which fires on SDL's timer thread and
+// is delivered to the main thread as a user event.
+class FrameScheduler {
+public:
+    FrameScheduler();
+
+    ~FrameScheduler();
+
+    // Always render at the frame cap, as the loop did before idling existed
+    void setContinuous(bool continuous);
+
+    void requestRedraw();
+
+    void beginAnimation();
+
+    void endAnimation();
+
+    bool isIdle();
+
+    // Blocks while idle, otherwise polls. Returns false if no event arrived.
+    bool waitEvent(SDL_Event *e);
+
+    // Returns true if the event was a scheduler timer and has been consumed
+    bool handleEvent(SDL_Event *e);
+
+    bool needsFrame();
+
+    void frameRendered();
+
+    // Runs callback on the main thread every intervalMs until it returns false
+    int addTimer(Uint32 intervalMs, std::function<bool()> callback);
+
+    void removeTimer(int id);
+
+private:
+    struct ScheduledTimer {
+        SDL_TimerID sdlTimer;
+        std::function<bool()> callback;
+    };
+
+    static Uint32 pushTimerEvent(Uint32 interval, void *param);
+
+    static Uint32 timerEventType;
+
+    bool continuous;
+    bool dirty;
+    int animations;
+    int nextTimerId;
+    std::unordered_map<int, ScheduledTimer> timers;
+};
+
+#endif
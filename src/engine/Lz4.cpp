@@ -0,0 +1,180 @@
+#include <cstring>
+#include <vector>
+#include "Lz4.h"
+
+static const int MIN_MATCH = 4;
+static const int LAST_LITERALS = 5;
+static const int MF_LIMIT = 12;
+static const int MAX_OFFSET = 65535;
+static const int HASH_LOG = 16;
+
+static uint32_t read32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static uint32_t hash32(uint32_t sequence) {
+    return (sequence * 2654435761U) >> (32 - HASH_LOG);
+}
+
+static uint8_t *writeLength(uint8_t *op, size_t length) {
+    while (length >= 255) {
+        *op++ = 255;
+        length -= 255;
+    }
+    *op++ = (uint8_t) length;
+    return op;
+}
+
+int lz4CompressBound(int srcSize) {
+    return srcSize + srcSize / 255 + 16;
+}
+
+int lz4CompressBlock(const uint8_t *src, int srcSize, uint8_t *dst, int dstCapacity) {
+    std::vector<int> table(1 << HASH_LOG, -1);
+
+    const uint8_t *ip = src;
+    const uint8_t *anchor = src;
+    const uint8_t *iend = src + srcSize;
+    const uint8_t *mfLimit = iend - MF_LIMIT;
+    const uint8_t *matchLimit = iend - LAST_LITERALS;
+    uint8_t *op = dst;
+    uint8_t *oend = dst + dstCapacity;
+
+    if (srcSize > MF_LIMIT) {
+        while (ip < mfLimit) {
+            uint32_t sequence = read32(ip);
+            uint32_t h = hash32(sequence);
+            int ref = table[h];
+            table[h] = (int) (ip - src);
+
+            if (ref < 0 || ip - (src + ref) > MAX_OFFSET || read32(src + ref) != sequence) {
+                ip++;
+                continue;
+            }
+
+            const uint8_t *match = src + ref;
+            const uint8_t *matchEnd = ip + MIN_MATCH;
+            const uint8_t *matchCursor = match + MIN_MATCH;
+            while (matchEnd < matchLimit && *matchEnd == *matchCursor) {
+                matchEnd++;
+                matchCursor++;
+            }
+
+            size_t literalLength = ip - anchor;
+            size_t matchLength = matchEnd - ip - MIN_MATCH;
+            size_t worstCase = 1 + literalLength / 255 + 1 + literalLength + 2 + matchLength / 255 + 1;
+            if ((size_t) (oend - op) < worstCase) {
+                return 0;
+            }
+
+            uint8_t *token = op++;
+            *token = (uint8_t) ((literalLength >= 15 ? 15 : literalLength) << 4);
+            if (literalLength >= 15) {
+                op = writeLength(op, literalLength - 15);
+            }
+            memcpy(op, anchor, literalLength);
+            op += literalLength;
+
+            size_t offset = ip - match;
+            *op++ = (uint8_t) (offset & 0xFF);
+            *op++ = (uint8_t) (offset >> 8);
+
+            *token |= (uint8_t) (matchLength >= 15 ? 15 : matchLength);
+            if (matchLength >= 15) {
+                op = writeLength(op, matchLength - 15);
+            }
+
+            ip = matchEnd;
+            anchor = ip;
+        }
+    }
+
+    size_t literalLength = iend - anchor;
+    if ((size_t) (oend - op) < 1 + literalLength / 255 + 1 + literalLength) {
+        return 0;
+    }
+
+    *op++ = (uint8_t) ((literalLength >= 15 ? 15 : literalLength) << 4);
+    if (literalLength >= 15) {
+        op = writeLength(op, literalLength - 15);
+    }
+    memcpy(op, anchor, literalLength);
+    op += literalLength;
+
+    return (int) (op - dst);
+}
+
+int lz4DecompressBlock(const uint8_t *src, int srcSize, uint8_t *dst, int dstCapacity) {
+    const uint8_t *ip = src;
+    const uint8_t *iend = src + srcSize;
+    uint8_t *op = dst;
+    uint8_t *oend = dst + dstCapacity;
+
+    while (ip < iend) {
+        unsigned token = *ip++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == 15) {
+            unsigned b;
+            do {
+                if (ip >= iend) {
+                    return -1;
+                }
+                b = *ip++;
+                literalLength += b;
+            } while (b == 255);
+        }
+
+        if (literalLength > (size_t) (iend - ip) || literalLength > (size_t) (oend - op)) {
+            return -1;
+        }
+        memcpy(op, ip, literalLength);
+        op += literalLength;
+        ip += literalLength;
+
+        // The last sequence of a block carries literals only
+        if (ip >= iend) {
+            break;
+        }
+
+        if (iend - ip < 2) {
+            return -1;
+        }
+        size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t) (op - dst)) {
+            return -1;
+        }
+
+        size_t matchLength = token & 15;
+        if (matchLength == 15) {
+            unsigned b;
+            do {
+                if (ip >= iend) {
+                    return -1;
+                }
+                b = *ip++;
+                matchLength += b;
+            } while (b == 255);
+        }
+        matchLength += MIN_MATCH;
+
+        if (matchLength > (size_t) (oend - op)) {
+            return -1;
+        }
+
+        const uint8_t *match = op - offset;
+        if (offset >= matchLength) {
+            memcpy(op, match, matchLength);
+            op += matchLength;
+        } else {
+            while (matchLength--) {
+                *op++ = *match++;
+            }
+        }
+    }
+
+    return (int) (op - dst);
+}
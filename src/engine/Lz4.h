@@ -0,0 +1,18 @@
+#ifndef CIV_LZ4_H
+#define CIV_LZ4_H
+
+#include <cstdint>
+
+// Minimal LZ4 block format codec used by the asset pack. Only the raw block
+// format is implemented (no frame header or checksums), which is all the pack
+// needs since every entry records its own stored and decoded sizes.
+
+int lz4CompressBound(int srcSize);
+
+// Returns the number of bytes written to dst, or 0 if dst is too small.
+int lz4CompressBlock(const uint8_t *src, int srcSize, uint8_t *dst, int dstCapacity);
+
+// Returns the number of bytes written to dst, or -1 if the input is malformed.
+int lz4DecompressBlock(const uint8_t *src, int srcSize, uint8_t *dst, int dstCapacity);
+
+#endif
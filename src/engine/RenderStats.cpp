@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <cstring>
+#include "RenderStats.h"
+#include "AllocationTracker.h"
+
+RenderStats &RenderStats::instance() {
+    static RenderStats stats;
+    return stats;
+}
+
+RenderStats::RenderStats() {
+    memset(&current, 0, sizeof(current));
+    memset(&last, 0, sizeof(last));
+    memset(history, 0, sizeof(history));
+    historyStart = 0;
+    historyCount = 0;
+    frameCount = 0;
+    frameStart = 0;
+    previousFrameStart = 0;
+    boundTexture = nullptr;
+}
+
+void RenderStats::beginFrame() {
+    previousFrameStart = frameStart;
+    frameStart = SDL_GetPerformanceCounter();
+    boundTexture = nullptr;
+}
+
+void RenderStats::endFrame() {
+    Uint64 now = SDL_GetPerformanceCounter();
+    AllocationTracker &allocations = AllocationTracker::instance();
+    allocations.endFrame();
+    current.allocations = allocations.getLastFrame().allocations;
+    current.allocatedBytes = allocations.getLastFrame().bytes;
+    current.peakHeapBytes = allocations.getLastFrame().peakBytes;
+
+    // The next allocation frame opens here rather than in beginFrame(), so
+    // it also covers the events handled while waiting for the next frame
+    allocations.beginFrame();
+
+    float msPerCount = 1000.0f / (float) SDL_GetPerformanceFrequency();
+
+    current.workMs = (float) (now - frameStart) * msPerCount;
+    current.frameMs = previousFrameStart != 0
+                      ? (float) (frameStart - previousFrameStart) * msPerCount
+                      : current.workMs;
+
+    // The interval ending at this frame's start belongs to the previous
+    // frame, so the first frame only contributes its work time
+    if (previousFrameStart != 0) {
+        int slot = (historyStart + historyCount) % STATS_HISTORY;
+        history[slot] = current.frameMs;
+        if (historyCount < STATS_HISTORY) {
+            historyCount++;
+        } else {
+            historyStart = (historyStart + 1) % STATS_HISTORY;
+        }
+    }
+
+    last = current;
+    memset(&current, 0, sizeof(current));
+    frameCount++;
+}
+
+void RenderStats::skipInterval() {
+    frameStart = 0;
+}
+
+void RenderStats::countDrawCall() {
+    current.drawCalls++;
+}
+
+void RenderStats::countSprite(SDL_Texture *texture) {
+    current.drawCalls++;
+    current.spritesSubmitted++;
+
+    if (texture != boundTexture) {
+        current.textureBinds++;
+        boundTexture = texture;
+    }
+}
+
+void RenderStats::countUpload(Uint64 bytes) {
+    current.textureBytesUploaded += bytes;
+}
+
+void RenderStats::countCulled(Uint32 tiles) {
+    current.tilesCulled += tiles;
+}
+
+void RenderStats::countTextureHit() {
+    current.textureHits++;
+}
+
+void RenderStats::countTextureMiss() {
+    current.textureMisses++;
+}
+
+const FrameStats &RenderStats::getLastFrame() {
+    return last;
+}
+
+Uint64 RenderStats::getFrameCount() {
+    return frameCount;
+}
+
+float RenderStats::getFramePercentile(float p) {
+    if (historyCount == 0) {
+        return 0;
+    }
+
+    float sorted[STATS_HISTORY];
+    for (int i = 0; i < historyCount; i++) {
+        sorted[i] = getHistoryFrameMs(i);
+    }
+
+    int rank = (int) (p / 100.0f * (historyCount - 1) + 0.5f);
+    rank = std::max(0, std::min(historyCount - 1, rank));
+    std::nth_element(sorted, sorted + rank, sorted + historyCount);
+
+    return sorted[rank];
+}
+
+float RenderStats::getAverageFrameMs() {
+    if (historyCount == 0) {
+        return 0;
+    }
+
+    float total = 0;
+    for (int i = 0; i < historyCount; i++) {
+        total += getHistoryFrameMs(i);
+    }
+
+    return total / historyCount;
+}
+
+float RenderStats::getFPS() {
+    float average = getAverageFrameMs();
+    return average > 0 ? 1000.0f / average : 0;
+}
+
+int RenderStats::getHistorySize() {
+    return historyCount;
+}
+
+float RenderStats::getHistoryFrameMs(int i) {
+    return history[(historyStart + i) % STATS_HISTORY];
+}
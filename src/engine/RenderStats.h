@@ -0,0 +1,82 @@
+#ifndef CIV_RENDERSTATS_H
+#define CIV_RENDERSTATS_H
+
+#include <SDL.h>
+
+struct FrameStats {
+    Uint32 drawCalls;
+    Uint32 spritesSubmitted;
+    Uint32 textureBinds;
+    Uint64 textureBytesUploaded;
+    Uint32 tilesCulled;
+    Uint32 textureHits;
+    Uint32 textureMisses;
+    // Heap activity from AllocationTracker since the previous frame ended, so
+    // including the events handled before this one; zero unless built with
+    // CIV_TRACK_ALLOCATIONS
+    Uint64 allocations;
+    Uint64 allocatedBytes;
+    Sint64 peakHeapBytes;
+    float frameMs;
+    float workMs;
+};
+
+const int STATS_HISTORY = 240;
+
+// Per-frame renderer counters. Texture and the main loop report into the
+// shared instance; the stats overlay and benchmarks read the completed
+// frame from getLastFrame() and the frame-time history.
+class RenderStats {
+public:
+    static RenderStats &instance();
+
+    RenderStats();
+
+    void beginFrame();
+
+    void endFrame();
+
+    // Call after the loop slept so the idle gap is not recorded as a frame
+    void skipInterval();
+
+    void countDrawCall();
+
+    void countSprite(SDL_Texture *texture);
+
+    void countUpload(Uint64 bytes);
+
+    void countCulled(Uint32 tiles);
+
+    void countTextureHit();
+
+    void countTextureMiss();
+
+    const FrameStats &getLastFrame();
+
+    Uint64 getFrameCount();
+
+    // Frame time in ms at percentile p (0-100) over the recorded history
+    float getFramePercentile(float p);
+
+    float getAverageFrameMs();
+
+    float getFPS();
+
+    int getHistorySize();
+
+    // i = 0 is the oldest recorded frame
+    float getHistoryFrameMs(int i);
+
+private:
+    FrameStats current;
+    FrameStats last;
+    float history[STATS_HISTORY];
+    int historyStart;
+    int historyCount;
+    Uint64 frameCount;
+    Uint64 frameStart;
+    Uint64 previousFrameStart;
+    SDL_Texture *boundTexture;
+};
+
+#endif
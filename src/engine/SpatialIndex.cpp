@@ -0,0 +1,145 @@
+#include "SpatialIndex.h"
+
+// Average entities per table slot before the table doubles in size
+static const size_t MAX_LOAD = 4;
+
+SpatialIndex::SpatialIndex(int bucketShift, int tableBits) :
+        bucketShift(bucketShift),
+        tableMask((1u << tableBits) - 1),
+        buckets(1u << tableBits),
+        count(0) {
+
+}
+
+void SpatialIndex::insert(Entity entity, int x, int y) {
+    if (contains(entity)) {
+        move(entity, x, y);
+        return;
+    }
+
+    if (entity.index >= locations.size()) {
+        locations.resize(entity.index + 1, Location{0, 0, 0, false});
+    } else if (locations[entity.index].used) {
+        // The slot still holds a destroyed entity whose index was reused
+        eraseAt(locations[entity.index].slot, locations[entity.index].index);
+        count--;
+    }
+
+    if (count >= buckets.size() * MAX_LOAD) {
+        int tableBits = 0;
+        while ((1u << tableBits) < buckets.size() * 2) {
+            tableBits++;
+        }
+        rehash(tableBits);
+    }
+
+    uint32_t slot = slotOf(x >> bucketShift, y >> bucketShift);
+    Bucket &bucket = buckets[slot];
+
+    locations[entity.index] = Location{slot, (uint32_t) bucket.size(), entity.generation, true};
+    bucket.push_back(Item{entity, x, y});
+    count++;
+}
+
+void SpatialIndex::remove(Entity entity) {
+    if (!contains(entity)) {
+        return;
+    }
+
+    Location &location = locations[entity.index];
+    eraseAt(location.slot, location.index);
+    location.used = false;
+    count--;
+}
+
+void SpatialIndex::move(Entity entity, int x, int y) {
+    if (!contains(entity)) {
+        insert(entity, x, y);
+        return;
+    }
+
+    Location &location = locations[entity.index];
+    uint32_t slot = slotOf(x >> bucketShift, y >> bucketShift);
+
+    if (slot == location.slot) {
+        Item &item = buckets[slot][location.index];
+        item.x = x;
+        item.y = y;
+        return;
+    }
+
+    eraseAt(location.slot, location.index);
+
+    Bucket &bucket = buckets[slot];
+    location.slot = slot;
+    location.index = (uint32_t) bucket.size();
+    bucket.push_back(Item{entity, x, y});
+}
+
+bool SpatialIndex::contains(Entity entity) const {
+    return entity.index < locations.size() &&
+           locations[entity.index].used &&
+           locations[entity.index].generation == entity.generation;
+}
+
+size_t SpatialIndex::size() const {
+    return count;
+}
+
+void SpatialIndex::clear() {
+    for (auto &bucket : buckets) {
+        bucket.clear();
+    }
+    locations.clear();
+    count = 0;
+}
+
+size_t SpatialIndex::queryPoint(int x, int y, std::vector<Entity> *out) const {
+    size_t before = out->size();
+    forEachAt(x, y, [out](Entity entity) {
+        out->push_back(entity);
+    });
+    return out->size() - before;
+}
+
+size_t SpatialIndex::queryRect(int x0, int y0, int x1, int y1, std::vector<Entity> *out) const {
+    size_t before = out->size();
+    forEachInRect(x0, y0, x1, y1, [out](Entity entity, int, int) {
+        out->push_back(entity);
+    });
+    return out->size() - before;
+}
+
+size_t SpatialIndex::queryRadius(int x, int y, int radius, std::vector<Entity> *out) const {
+    size_t before = out->size();
+    forEachInRadius(x, y, radius, [out](Entity entity, int, int) {
+        out->push_back(entity);
+    });
+    return out->size() - before;
+}
+
+void SpatialIndex::eraseAt(uint32_t slot, uint32_t index) {
+    Bucket &bucket = buckets[slot];
+
+    if (index != bucket.size() - 1) {
+        bucket[index] = bucket.back();
+        locations[bucket[index].entity.index].index = index;
+    }
+    bucket.pop_back();
+}
+
+void SpatialIndex::rehash(int tableBits) {
+    std::vector<Bucket> old(1u << tableBits);
+    old.swap(buckets);
+    tableMask = (1u << tableBits) - 1;
+
+    for (auto &bucket : old) {
+        for (const Item &item : bucket) {
+            uint32_t slot = slotOf(item.x >> bucketShift, item.y >> bucketShift);
+            Location &location = locations[item.entity.index];
+            location.slot = slot;
+            location.index = (uint32_t) buckets[slot].size();
+            buckets[slot].push_back(item);
+        }
+    }
+}
@@ -0,0 +1,116 @@
+#ifndef CIV_SPATIALINDEX_H
+#define CIV_SPATIALINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Entity.h"
+
+// Spatial hash over tile coordinates. Tiles are grouped into square buckets
+// of (1 << bucketShift) tiles per side, and bucket coordinates are hashed
+// into a power-of-two table that grows with the entity count, so memory does
+// not depend on map size and slots stay short. Each table slot keeps a
+// packed list of (entity, x, y); cells that collide in the table share a
+// slot and are told apart by their coordinates.
+class SpatialIndex {
+public:
+    explicit SpatialIndex(int bucketShift = 1, int tableBits = 12);
+
+    void insert(Entity entity, int x, int y);
+
+    void remove(Entity entity);
+
+    // Moving within the same bucket only rewrites the stored coordinates
+    void move(Entity entity, int x, int y);
+
+    bool contains(Entity entity) const;
+
+    size_t size() const;
+
+    void clear();
+
+    template<typename F>
+    void forEachAt(int x, int y, F fn) const {
+        const Bucket &bucket = buckets[slotOf(x >> bucketShift, y >> bucketShift)];
+        for (const Item &item : bucket) {
+            if (item.x == x && item.y == y) {
+                fn(item.entity);
+            }
+        }
+    }
+
+    // Visits every entity with x0 <= x <= x1 and y0 <= y <= y1
+    template<typename F>
+    void forEachInRect(int x0, int y0, int x1, int y1, F fn) const {
+        int bx0 = x0 >> bucketShift;
+        int by0 = y0 >> bucketShift;
+        int bx1 = x1 >> bucketShift;
+        int by1 = y1 >> bucketShift;
+
+        for (int by = by0; by <= by1; by++) {
+            for (int bx = bx0; bx <= bx1; bx++) {
+                const Bucket &bucket = buckets[slotOf(bx, by)];
+                for (const Item &item : bucket) {
+                    if (item.x >= x0 && item.x <= x1 && item.y >= y0 && item.y <= y1 &&
+                        (item.x >> bucketShift) == bx && (item.y >> bucketShift) == by) {
+                        fn(item.entity, item.x, item.y);
+                    }
+                }
+            }
+        }
+    }
+
+    // Visits every entity within a Euclidean tile distance of radius
+    template<typename F>
+    void forEachInRadius(int x, int y, int radius, F fn) const {
+        int radiusSquared = radius * radius;
+        forEachInRect(x - radius, y - radius, x + radius, y + radius,
+                      [&](Entity entity, int ex, int ey) {
+                          int dx = ex - x;
+                          int dy = ey - y;
+                          if (dx * dx + dy * dy <= radiusSquared) {
+                              fn(entity, ex, ey);
+                          }
+                      });
+    }
+
+    size_t queryPoint(int x, int y, std::vector<Entity> *out) const;
+
+    size_t queryRect(int x0, int y0, int x1, int y1, std::vector<Entity> *out) const;
+
+    size_t queryRadius(int x, int y, int radius, std::vector<Entity> *out) const;
+
+private:
+    struct Item {
+        Entity entity;
+        int x;
+        int y;
+    };
+
+    struct Location {
+        uint32_t slot;
+        uint32_t index;
+        uint32_t generation;
+        bool used;
+    };
+
+    typedef std::vector<Item> Bucket;
+
+    uint32_t slotOf(int bx, int by) const {
+        uint32_t h = (uint32_t) bx * 73856093u ^ (uint32_t) by * 19349663u;
+        return (h ^ (h >> 15)) & tableMask;
+    }
+
+    void eraseAt(uint32_t slot, uint32_t index);
+
+    void rehash(int tableBits);
+
+    int bucketShift;
+    uint32_t tableMask;
+    std::vector<Bucket> buckets;
+    std::vector<Location> locations;
+    size_t count;
+};
+
+#endif
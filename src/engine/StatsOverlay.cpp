@@ -0,0 +1,117 @@
+#include "StatsOverlay.h"
+#include "AllocationTracker.h"
+#include "FrameArena.h"
+
+static const int GRAPH_WIDTH = STATS_HISTORY * 2;
+static const int GRAPH_HEIGHT = 120;
+static const float GRAPH_MAX_MS = 50.0f;
+static const int PADDING = 12;
+
+StatsOverlay::StatsOverlay(SDL_Renderer *renderer, TTF_Font *font) :
+        renderer(renderer),
+        font(font),
+        visible(false),
+        lastRefresh(0) {
+
+}
+
+void StatsOverlay::toggle() {
+    visible = !visible;
+    lastRefresh = 0;
+}
+
+bool StatsOverlay::isVisible() {
+    return visible;
+}
+
+void StatsOverlay::refreshText() {
+    RenderStats &stats = RenderStats::instance();
+    const FrameStats &frame = stats.getLastFrame();
+    SDL_Color textColor = {0xFF, 0xFF, 0xFF, 0xFF};
+    FrameArena &arena = FrameArena::local();
+    const char *text[STATS_OVERLAY_LINES];
+
+    text[0] = arena.format("%.1f fps  (%.2f ms avg)",
+                           stats.getFPS(), stats.getAverageFrameMs());
+    text[1] = arena.format("frame p50 %.2f  p95 %.2f  p99 %.2f ms",
+                           stats.getFramePercentile(50), stats.getFramePercentile(95),
+                           stats.getFramePercentile(99));
+    text[2] = arena.format("work %.2f ms", frame.workMs);
+    text[3] = arena.format("draw calls %u  sprites %u  binds %u",
+                           frame.drawCalls, frame.spritesSubmitted, frame.textureBinds);
+    text[4] = arena.format("uploaded %.1f KB", frame.textureBytesUploaded / 1024.0);
+    text[5] = arena.format("tiles culled %u", frame.tilesCulled);
+    text[6] = arena.format("texture hits %u  misses %u", frame.textureHits, frame.textureMisses);
+    text[7] = AllocationTracker::isEnabled()
+              ? arena.format("allocs %llu  %.1f KB  heap peak %.1f MB",
+                             (unsigned long long) frame.allocations,
+                             frame.allocatedBytes / 1024.0,
+                             frame.peakHeapBytes / (1024.0 * 1024.0))
+              : "allocs not tracked";
+
+    for (int i = 0; i < STATS_OVERLAY_LINES; i++) {
+        lines[i].loadFromRenderedText(renderer, font, text[i], textColor);
+    }
+}
+
+void StatsOverlay::render(int x, int y) {
+    if (!visible) {
+        return;
+    }
+
+    Uint32 now = SDL_GetTicks();
+    if (lastRefresh == 0 || now - lastRefresh >= STATS_OVERLAY_REFRESH_MS) {
+        refreshText();
+        lastRefresh = now;
+    }
+
+    int textHeight = 0;
+    for (int i = 0; i < STATS_OVERLAY_LINES; i++) {
+        textHeight += lines[i].getHeight();
+    }
+
+    SDL_Rect background = {x, y, GRAPH_WIDTH + PADDING * 2, textHeight + GRAPH_HEIGHT + PADDING * 3};
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0xC0);
+    SDL_RenderFillRect(renderer, &background);
+    RenderStats::instance().countDrawCall();
+
+    int lineY = y + PADDING;
+    for (int i = 0; i < STATS_OVERLAY_LINES; i++) {
+        lines[i].render(renderer, x + PADDING, lineY);
+        lineY += lines[i].getHeight();
+    }
+
+    renderGraph(x + PADDING, lineY + PADDING, GRAPH_WIDTH, GRAPH_HEIGHT);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+}
+
+void StatsOverlay::renderGraph(int x, int y, int w, int h) {
+    RenderStats &stats = RenderStats::instance();
+
+    // Reference lines at 60 and 30 fps
+    const float targets[] = {1000.0f / 60, 1000.0f / 30};
+    SDL_SetRenderDrawColor(renderer, 0x80, 0x80, 0x80, 0xFF);
+    for (float target : targets) {
+        int lineY = y + h - (int) (target / GRAPH_MAX_MS * h);
+        SDL_RenderDrawLine(renderer, x, lineY, x + w, lineY);
+        stats.countDrawCall();
+    }
+
+    SDL_Point points[STATS_HISTORY];
+    int count = stats.getHistorySize();
+    for (int i = 0; i < count; i++) {
+        float ms = stats.getHistoryFrameMs(i);
+        if (ms > GRAPH_MAX_MS) {
+            ms = GRAPH_MAX_MS;
+        }
+        points[i].x = x + (w - count * w / STATS_HISTORY) + i * w / STATS_HISTORY;
+        points[i].y = y + h - (int) (ms / GRAPH_MAX_MS * h);
+    }
+
+    if (count > 1) {
+        SDL_SetRenderDrawColor(renderer, 0x40, 0xFF, 0x40, 0xFF);
+        SDL_RenderDrawLines(renderer, points, count);
+        stats.countDrawCall();
+    }
+}
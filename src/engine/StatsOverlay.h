@@ -0,0 +1,38 @@
+#ifndef CIV_STATSOVERLAY_H
+#define CIV_STATSOVERLAY_H
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+
+#include "RenderStats.h"
+#include "Texture.h"
+
+const int STATS_OVERLAY_LINES = 8;
+const Uint32 STATS_OVERLAY_REFRESH_MS = 250;
+
+// Toggleable on-screen readout of RenderStats with a frame-time graph.
+// Text is only re-rendered a few times a second so the overlay does not
+// dominate the upload counters it is displaying.
+class StatsOverlay {
+public:
+    StatsOverlay(SDL_Renderer *renderer, TTF_Font *font);
+
+    void toggle();
+
+    bool isVisible();
+
+    void render(int x, int y);
+
+private:
+    void refreshText();
+
+    void renderGraph(int x, int y, int w, int h);
+
+    SDL_Renderer *renderer;
+    TTF_Font *font;
+    bool visible;
+    Uint32 lastRefresh;
+    Texture lines[STATS_OVERLAY_LINES];
+};
+
+#endif
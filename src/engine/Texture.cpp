@@ -1,10 +1,19 @@
 #include <SDL_image.h>
+#include <vector>
 #include "Texture.h"
+#include "AssetPack.h"
+#include "RenderStats.h"
+#include "TextureResidency.h"
 
 Texture::Texture() {
     mTexture = nullptr;
     mWidth = 0;
     mHeight = 0;
+    mColorMod = {0xFF, 0xFF, 0xFF, 0xFF};
+    mBlendMode = SDL_BLENDMODE_BLEND;
+    mModsSet = false;
+    mResidency = nullptr;
+    mLastUsedFrame = 0;
 }
 
 Texture::~Texture() {
@@ -30,6 +39,7 @@ bool Texture::loadFromFile(SDL_Renderer *renderer, std::string path) {
         } else {
             mWidth = loadedSurface->w;
             mHeight = loadedSurface->h;
+            RenderStats::instance().countUpload((Uint64) mWidth * mHeight * 4);
         }
 
         SDL_FreeSurface(loadedSurface);
@@ -39,15 +49,64 @@ bool Texture::loadFromFile(SDL_Renderer *renderer, std::string path) {
     return mTexture != nullptr;
 }
 
+bool Texture::loadFromPack(SDL_Renderer *renderer, AssetPack *pack, std::string name) {
+    const AssetPackEntry *entry = pack->find(name);
+    if (entry == nullptr || entry->type != ASSET_TYPE_IMAGE) {
+        printf("Image %s is not in the asset pack!\n", name.c_str());
+        return false;
+    }
+
+    std::vector<uint8_t> scratch;
+    const uint8_t *pixels = pack->getPixels(entry, &scratch);
+    if (pixels == nullptr) {
+        printf("Image %s in the asset pack is corrupt!\n", name.c_str());
+        return false;
+    }
+
+    return loadFromPixels(renderer, pixels, entry->width, entry->height);
+}
+
+bool Texture::loadFromPixels(SDL_Renderer *renderer, const void *pixels, int width, int height) {
+    free();
+
+    SDL_Texture *newTexture = SDL_CreateTexture(renderer,
+                                                SDL_PIXELFORMAT_RGBA32,
+                                                SDL_TEXTUREACCESS_STATIC,
+                                                width,
+                                                height);
+    if (newTexture == nullptr) {
+        printf("Cannot create %dx%d texture! SDL Error: %s\n", width, height, SDL_GetError());
+    } else if (SDL_UpdateTexture(newTexture, nullptr, pixels, width * 4) != 0) {
+        printf("Cannot upload %dx%d texture! SDL Error: %s\n", width, height, SDL_GetError());
+        SDL_DestroyTexture(newTexture);
+        newTexture = nullptr;
+    } else {
+        SDL_SetTextureBlendMode(newTexture, SDL_BLENDMODE_BLEND);
+        mWidth = width;
+        mHeight = height;
+        RenderStats::instance().countUpload((Uint64) mWidth * mHeight * 4);
+    }
+
+    mTexture = newTexture;
+    return mTexture != nullptr;
+}
+
 #if defined(SDL_TTF_MAJOR_VERSION)
 
 bool Texture::loadFromRenderedText(SDL_Renderer *renderer,
                                    TTF_Font *gFont,
                                    std::string textureText,
                                    SDL_Color textColor) {
+    return loadFromRenderedText(renderer, gFont, textureText.c_str(), textColor);
+}
+
+bool Texture::loadFromRenderedText(SDL_Renderer *renderer,
+                                   TTF_Font *gFont,
+                                   const char *textureText,
+                                   SDL_Color textColor) {
     free();
 
-    SDL_Surface *textSurface = TTF_RenderText_Solid(gFont, textureText.c_str(), textColor);
+    SDL_Surface *textSurface = TTF_RenderText_Solid(gFont, textureText, textColor);
     if (textSurface != nullptr) {
         mTexture = SDL_CreateTextureFromSurface(renderer, textSurface);
         if (mTexture == nullptr) {
@@ -55,6 +114,7 @@ bool Texture::loadFromRenderedText(SDL_Renderer *renderer,
         } else {
             mWidth = textSurface->w;
             mHeight = textSurface->h;
+            RenderStats::instance().countUpload((Uint64) mWidth * mHeight * 4);
         }
 
         SDL_FreeSurface(textSurface);
@@ -77,15 +137,38 @@ void Texture::free() {
     }
 }
 
+void Texture::unload() {
+    if (mTexture != nullptr) {
+        SDL_DestroyTexture(mTexture);
+        mTexture = nullptr;
+    }
+}
+
+void Texture::applyMods() {
+    if (mModsSet && mTexture != nullptr) {
+        SDL_SetTextureColorMod(mTexture, mColorMod.r, mColorMod.g, mColorMod.b);
+        SDL_SetTextureAlphaMod(mTexture, mColorMod.a);
+        SDL_SetTextureBlendMode(mTexture, mBlendMode);
+    }
+}
+
 void Texture::setColor(Uint8 red, Uint8 green, Uint8 blue) {
+    mColorMod.r = red;
+    mColorMod.g = green;
+    mColorMod.b = blue;
+    mModsSet = true;
     SDL_SetTextureColorMod(mTexture, red, green, blue);
 }
 
 void Texture::setBlendMode(SDL_BlendMode blending) {
+    mBlendMode = blending;
+    mModsSet = true;
     SDL_SetTextureBlendMode(mTexture, blending);
 }
 
 void Texture::setAlpha(Uint8 alpha) {
+    mColorMod.a = alpha;
+    mModsSet = true;
     SDL_SetTextureAlphaMod(mTexture, alpha);
 }
 
@@ -96,6 +179,10 @@ void Texture::render(SDL_Renderer *renderer,
                      double angle,
                      SDL_Point *center,
                      SDL_RendererFlip flip) {
+    if (mResidency != nullptr) {
+        mResidency->touch(this);
+    }
+
     SDL_Rect renderQuad = {x, y, mWidth, mHeight};
 
     if (clip != nullptr) {
@@ -104,6 +191,7 @@ void Texture::render(SDL_Renderer *renderer,
     }
 
     SDL_RenderCopyEx(renderer, mTexture, clip, &renderQuad, angle, center, flip);
+    RenderStats::instance().countSprite(mTexture);
 }
 
 int Texture::getWidth() {
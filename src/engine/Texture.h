@@ -5,7 +5,12 @@
 #include <SDL.h>
 #include <SDL_ttf.h>
 
+class AssetPack;
+class TextureResidency;
+
 class Texture {
+    friend class TextureResidency;
+
 public:
     Texture();
 
@@ -13,6 +18,10 @@ public:
 
     bool loadFromFile(SDL_Renderer *renderer, std::string path);
 
+    bool loadFromPack(SDL_Renderer *renderer, AssetPack *pack, std::string name);
+
+    bool loadFromPixels(SDL_Renderer *renderer, const void *pixels, int width, int height);
+
 #if defined(SDL_TTF_MAJOR_VERSION)
 
     bool loadFromRenderedText(SDL_Renderer *renderer,
@@ -20,6 +29,11 @@ public:
                               std::string textureText,
                               SDL_Color textColor);
 
+    bool loadFromRenderedText(SDL_Renderer *renderer,
+                              TTF_Font *gFont,
+                              const char *textureText,
+                              SDL_Color textColor);
+
 #endif
 
     void free();
@@ -43,9 +57,22 @@ public:
     int getHeight();
 
 private:
+    // Drops the GPU texture but keeps the size, for residency eviction
+    void unload();
+
+    void applyMods();
+
     SDL_Texture *mTexture;
     int mWidth;
     int mHeight;
+
+    SDL_Color mColorMod;
+    SDL_BlendMode mBlendMode;
+    bool mModsSet;
+
+    TextureResidency *mResidency;
+    std::string mSource;
+    Uint64 mLastUsedFrame;
 };
 
 #endif
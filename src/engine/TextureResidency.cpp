@@ -0,0 +1,150 @@
+#include "TextureResidency.h"
+#include "AssetPack.h"
+#include "RenderStats.h"
+
+static Uint64 textureBytes(Texture *texture) {
+    return (Uint64) texture->getWidth() * texture->getHeight() * 4;
+}
+
+TextureResidency::TextureResidency(SDL_Renderer *renderer, Uint64 budgetBytes) :
+        renderer(renderer),
+        pack(nullptr),
+        budget(budgetBytes),
+        residentBytes(0),
+        frame(1),
+        hits(0),
+        misses(0),
+        evictions(0) {
+
+}
+
+TextureResidency::~TextureResidency() {
+    for (auto &entry : textures) {
+        entry.second->mResidency = nullptr;
+        entry.second->free();
+    }
+}
+
+void TextureResidency::setAssetPack(AssetPack *assetPack) {
+    this->pack = assetPack;
+}
+
+void TextureResidency::setBudget(Uint64 budgetBytes) {
+    this->budget = budgetBytes;
+    enforceBudget();
+}
+
+Texture *TextureResidency::acquire(std::string path) {
+    auto it = textures.find(path);
+    if (it != textures.end()) {
+        return it->second.get();
+    }
+
+    std::unique_ptr<Texture> texture(new Texture());
+    texture->mSource = path;
+    if (!load(texture.get())) {
+        return nullptr;
+    }
+
+    Texture *acquired = texture.get();
+    acquired->mResidency = this;
+    textures[path] = std::move(texture);
+
+    makeResident(acquired);
+    enforceBudget();
+
+    return acquired;
+}
+
+void TextureResidency::beginFrame() {
+    frame++;
+}
+
+void TextureResidency::touch(Texture *texture) {
+    // Only the first draw of a texture in a frame does any bookkeeping. That
+    // includes a failed reload: it is retried next frame, not on every draw.
+    // Textures drawn this frame are never evicted, so a resident one stays
+    // resident until the frame ends.
+    if (texture->mLastUsedFrame == frame) {
+        return;
+    }
+    texture->mLastUsedFrame = frame;
+
+    if (texture->mTexture != nullptr) {
+        hits++;
+        RenderStats::instance().countTextureHit();
+        lru.splice(lru.begin(), lru, positions[texture]);
+        return;
+    }
+
+    misses++;
+    RenderStats::instance().countTextureMiss();
+    if (load(texture)) {
+        makeResident(texture);
+        enforceBudget();
+    }
+}
+
+Uint64 TextureResidency::getBudget() {
+    return budget;
+}
+
+Uint64 TextureResidency::getResidentBytes() {
+    return residentBytes;
+}
+
+Uint64 TextureResidency::getHits() {
+    return hits;
+}
+
+Uint64 TextureResidency::getMisses() {
+    return misses;
+}
+
+Uint64 TextureResidency::getEvictions() {
+    return evictions;
+}
+
+float TextureResidency::getHitRate() {
+    Uint64 total = hits + misses;
+    return total > 0 ? (float) hits / total : 1.0f;
+}
+
+bool TextureResidency::load(Texture *texture) {
+    bool loaded;
+    if (pack != nullptr && pack->isOpen() && pack->find(texture->mSource) != nullptr) {
+        loaded = texture->loadFromPack(renderer, pack, texture->mSource);
+    } else {
+        loaded = texture->loadFromFile(renderer, texture->mSource);
+    }
+
+    if (loaded) {
+        texture->applyMods();
+    }
+
+    return loaded;
+}
+
+void TextureResidency::makeResident(Texture *texture) {
+    lru.push_front(texture);
+    positions[texture] = lru.begin();
+    residentBytes += textureBytes(texture);
+    texture->mLastUsedFrame = frame;
+}
+
+void TextureResidency::enforceBudget() {
+    while (residentBytes > budget && !lru.empty()) {
+        Texture *victim = lru.back();
+
+        // Everything further up the list was drawn even more recently
+        if (victim->mLastUsedFrame == frame) {
+            break;
+        }
+
+        lru.pop_back();
+        positions.erase(victim);
+        residentBytes -= textureBytes(victim);
+        victim->unload();
+        evictions++;
+    }
+}
@@ -0,0 +1,69 @@
+#ifndef CIV_TEXTURERESIDENCY_H
+#define CIV_TEXTURERESIDENCY_H
+
+#include <SDL.h>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "Texture.h"
+
+class AssetPack;
+
+// Keeps GPU texture memory under a budget. Textures obtained from acquire()
+// are owned here and may be evicted, least recently drawn first, whenever
+// the budget is exceeded; rendering an evicted texture reloads it from the
+// asset pack if it is there, or from disk. Textures drawn during the current
+// frame are never evicted, so the budget can be exceeded temporarily.
+class TextureResidency {
+public:
+    TextureResidency(SDL_Renderer *renderer, Uint64 budgetBytes);
+
+    ~TextureResidency();
+
+    void setAssetPack(AssetPack *pack);
+
+    void setBudget(Uint64 budgetBytes);
+
+    // Returns the same texture for the same path, or nullptr if loading failed
+    Texture *acquire(std::string path);
+
+    void beginFrame();
+
+    void touch(Texture *texture);
+
+    Uint64 getBudget();
+
+    Uint64 getResidentBytes();
+
+    Uint64 getHits();
+
+    Uint64 getMisses();
+
+    Uint64 getEvictions();
+
+    float getHitRate();
+
+private:
+    bool load(Texture *texture);
+
+    void makeResident(Texture *texture);
+
+    void enforceBudget();
+
+    SDL_Renderer *renderer;
+    AssetPack *pack;
+    Uint64 budget;
+    Uint64 residentBytes;
+    Uint64 frame;
+    Uint64 hits;
+    Uint64 misses;
+    Uint64 evictions;
+    std::unordered_map<std::string, std::unique_ptr<Texture>> textures;
+    // Resident textures only, most recently drawn first
+    std::list<Texture *> lru;
+    std::unordered_map<Texture *, std::list<Texture *>::iterator> positions;
+};
+
+#endif
@@ -1,38 +1,72 @@
 #include "Tile.h"
+#include "../world/TerrainRegistry.h"
+
+static const Uint8 HIGHLIGHT_ALPHA = 0x50;
 
 Tile::Tile(SDL_Renderer *renderer,
            Texture *texture,
            int x,
            int y,
-           SDL_Rect clip) :
+           SDL_Rect clip,
+           int terrain) :
         renderer(renderer),
         texture(texture),
         x(x),
         y(y),
-        clip(clip) {
+        clip(clip),
+        terrain(terrain) {
 
 }
 
 Tile::~Tile() = default;
 
+bool Tile::isVisible(const SDL_Rect &view) {
+    return x < view.x + view.w &&
+           x + clip.w > view.x &&
+           y < view.y + view.h &&
+           y + clip.h > view.y;
+}
+
 void Tile::render() {
     texture->render(renderer, x, y, &clip);
 
-    for (auto layer : layers) {
+    for (auto &layer : layers) {
         layer.render();
     }
 }
 
+void Tile::renderHighlight() {
+    texture->setBlendMode(SDL_BLENDMODE_ADD);
+    texture->setAlpha(HIGHLIGHT_ALPHA);
+    texture->render(renderer, x, y, &clip);
+    texture->setBlendMode(SDL_BLENDMODE_BLEND);
+    texture->setAlpha(0xFF);
+}
+
 void Tile::addLayer(TileLayer layer) {
     layers.emplace_back(layer);
 }
 
 float Tile::getFood() {
-    float food = 0;
+    return (float) terrainInfo(terrain).food;
+}
 
-    for (auto layer: layers) {
-        food += layer.getFood();
-    }
+int Tile::getTerrain() const {
+    return terrain;
+}
+
+int Tile::getX() const {
+    return x;
+}
+
+int Tile::getY() const {
+    return y;
+}
+
+const SDL_Rect &Tile::getClip() const {
+    return clip;
+}
 
-    return food;
+const std::vector<TileLayer> &Tile::getLayers() const {
+    return layers;
 }
@@ -13,7 +13,8 @@ public:
          Texture *texture,
          int x,
          int y,
-         SDL_Rect clip);
+         SDL_Rect clip,
+         int terrain);
 
     ~Tile();
 
@@ -21,14 +22,31 @@ public:
 
     float getFood();
 
+    int getTerrain() const;
+
+    int getX() const;
+
+    int getY() const;
+
+    const SDL_Rect &getClip() const;
+
+    // In draw order, so the last layer is on top
+    const std::vector<TileLayer> &getLayers() const;
+
+    bool isVisible(const SDL_Rect &view);
+
     void render();
 
+    // Draws the sprite again additively, for hover feedback
+    void renderHighlight();
+
 private:
     SDL_Renderer *renderer;
     Texture *texture;
     SDL_Rect clip;
     int x;
     int y;
+    int terrain;
     std::vector<TileLayer> layers;
 
 };
@@ -11,54 +11,30 @@ TileLayer::TileLayer(SDL_Renderer *renderer,
         x(x),
         y(y),
         clip(clip),
-        zIndex(zIndex),
-        food(0.0),
-        production(0.0),
-        gold(0.0),
-        science(0.0 ){
+        zIndex(zIndex) {
 
 }
 
 TileLayer::~TileLayer() = default;
 
-float TileLayer::getFood() {
-    return food;
-}
-
-float TileLayer::getProduction() {
-    return production;
-}
-
-float TileLayer::getGold() {
-    return gold;
-}
-
-float TileLayer::getScience() {
-    return science;
-}
-
 int TileLayer::getZIndex() {
     return zIndex;
 }
 
-void TileLayer::setFood(float f) {
-    this->food = f;
-}
-
-void TileLayer::setProduction(float p) {
-    this->production = p;
+void TileLayer::setZIndex(int z) {
+    this->zIndex = z;
 }
 
-void TileLayer::setGold(float g) {
-    this->gold = g;
+int TileLayer::getX() const {
+    return x;
 }
 
-void TileLayer::setScience(float s) {
-    this->science = s;
+int TileLayer::getY() const {
+    return y;
 }
 
-void TileLayer::setZIndex(int z) {
-    this->zIndex = z;
+const SDL_Rect &TileLayer::getClip() const {
+    return clip;
 }
 
 void TileLayer::render() {
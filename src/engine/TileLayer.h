@@ -15,25 +15,15 @@ public:
 
     ~TileLayer();
 
-    float getFood();
-
-    float getProduction();
-
-    float getGold();
-
-    float getScience();
-
     int getZIndex();
 
-    void setFood(float f);
-
-    void setProduction(float p);
+    void setZIndex(int z);
 
-    void setGold(float g);
+    int getX() const;
 
-    void setScience(float s);
+    int getY() const;
 
-    void setZIndex(int z);
+    const SDL_Rect &getClip() const;
 
     void render();
 
@@ -44,10 +34,6 @@ private:
     int x;
     int y;
     int zIndex;
-    float food;
-    float production;
-    float gold;
-    float science;
 };
 
 #endif
@@ -0,0 +1,181 @@
+#include <SDL_image.h>
+#include <cstdio>
+#include <cstring>
+#include "TilePicker.h"
+#include "constants.h"
+
+static uint32_t maskKey(const SDL_Rect &clip) {
+    return (uint32_t) clip.x << 16 | (uint32_t) clip.y;
+}
+
+// Rounds towards negative infinity, for points above or left of the map
+static int floorDiv(int a, int b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+AlphaMask::AlphaMask() :
+        width(0),
+        height(0),
+        stride(0) {
+
+}
+
+void AlphaMask::build(const uint8_t *rgba, int pitch, const SDL_Rect &clip) {
+    width = clip.w;
+    height = clip.h;
+    stride = (width + 63) / 64;
+    bits.assign((size_t) stride * height, 0);
+
+    for (int y = 0; y < height; y++) {
+        const uint8_t *row = rgba + (size_t) (clip.y + y) * pitch + (size_t) clip.x * 4;
+        uint64_t *words = bits.data() + (size_t) y * stride;
+
+        for (int x = 0; x < width; x++) {
+            if (row[x * 4 + 3] >= PICK_ALPHA_THRESHOLD) {
+                words[x / 64] |= (uint64_t) 1 << (x % 64);
+            }
+        }
+    }
+}
+
+bool AlphaMask::test(int x, int y) const {
+    if (x < 0 || x >= width || y < 0 || y >= height) {
+        return false;
+    }
+
+    return (bits[(size_t) y * stride + x / 64] >> (x % 64)) & 1;
+}
+
+bool TilePicker::loadMasks(AssetPack *pack, std::string path, const SDL_Rect clips[], int count) {
+    const uint8_t *pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> scratch;
+
+    const AssetPackEntry *entry = pack != nullptr && pack->isOpen() ? pack->find(path) : nullptr;
+    if (entry != nullptr && entry->type == ASSET_TYPE_IMAGE) {
+        pixels = pack->getPixels(entry, &scratch);
+        width = (int) entry->width;
+        height = (int) entry->height;
+    } else {
+        // Same decode as civ_pack, so loose and packed masks match
+        SDL_Surface *loadedSurface = IMG_Load(path.c_str());
+        if (loadedSurface == nullptr) {
+            printf("Unable to load image %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError());
+            return false;
+        }
+
+        SDL_SetColorKey(loadedSurface,
+                        SDL_TRUE,
+                        SDL_MapRGB(loadedSurface->format, 0, 0xFF, 0xFF));
+
+        SDL_Surface *rgba = SDL_ConvertSurfaceFormat(loadedSurface, SDL_PIXELFORMAT_RGBA32, 0);
+        SDL_FreeSurface(loadedSurface);
+        if (rgba == nullptr) {
+            printf("Unable to convert %s to RGBA! SDL Error: %s\n", path.c_str(), SDL_GetError());
+            return false;
+        }
+
+        width = rgba->w;
+        height = rgba->h;
+        scratch.resize((size_t) width * height * 4);
+
+        SDL_LockSurface(rgba);
+        for (int row = 0; row < height; row++) {
+            memcpy(scratch.data() + (size_t) row * width * 4,
+                   (const uint8_t *) rgba->pixels + (size_t) row * rgba->pitch,
+                   (size_t) width * 4);
+        }
+        SDL_UnlockSurface(rgba);
+        SDL_FreeSurface(rgba);
+
+        pixels = scratch.data();
+    }
+
+    if (pixels == nullptr) {
+        printf("Image %s in the asset pack is corrupt!\n", path.c_str());
+        return false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        const SDL_Rect &clip = clips[i];
+        if (clip.x < 0 || clip.y < 0 || clip.x + clip.w > width || clip.y + clip.h > height) {
+            printf("Clip %d,%d %dx%d is outside %s!\n", clip.x, clip.y, clip.w, clip.h, path.c_str());
+            continue;
+        }
+
+        masks[maskKey(clip)].build(pixels, width * 4, clip);
+    }
+
+    return true;
+}
+
+bool TilePicker::hitTest(const SDL_Rect &clip, int x, int y) const {
+    if (x < 0 || x >= clip.w || y < 0 || y >= clip.h) {
+        return false;
+    }
+
+    auto mask = masks.find(maskKey(clip));
+    return mask == masks.end() || mask->second.test(x, y);
+}
+
+PickResult TilePicker::pick(const std::vector<Tile> &tiles, int columns, int x, int y) const {
+    PickResult result = {PICK_NONE, PICK_NONE};
+    int rows = columns > 0 ? (int) tiles.size() / columns : 0;
+
+    // Sprites are TILE_WIDTH wide with no horizontal overlap, but each is
+    // TILE_HEIGHT tall starting TILE_SIZE / 2 above its row, so a point is
+    // covered by at most TILE_HEIGHT / TILE_SIZE + 1 rows of one column
+    int column = floorDiv(x, TILE_WIDTH);
+    if (column < 0 || column >= columns) {
+        return result;
+    }
+
+    int lastRow = floorDiv(y + TILE_SIZE / 2, TILE_SIZE);
+    int firstRow = floorDiv(y + TILE_SIZE / 2 - TILE_HEIGHT, TILE_SIZE) + 1;
+    if (lastRow > rows - 1) {
+        lastRow = rows - 1;
+    }
+    if (firstRow < 0) {
+        firstRow = 0;
+    }
+
+    // Later rows, and later layers within a tile, are drawn on top
+    for (int row = lastRow; row >= firstRow; row--) {
+        int index = row * columns + column;
+        const Tile &tile = tiles[index];
+        const std::vector<TileLayer> &layers = tile.getLayers();
+
+        for (int layer = (int) layers.size() - 1; layer >= 0; layer--) {
+            if (hitTest(layers[layer].getClip(), x - layers[layer].getX(), y - layers[layer].getY())) {
+                result.tile = index;
+                result.layer = layer;
+                return result;
+            }
+        }
+
+        if (hitTest(tile.getClip(), x - tile.getX(), y - tile.getY())) {
+            result.tile = index;
+            return result;
+        }
+    }
+
+    return result;
+}
+
+SDL_Point windowToRenderer(SDL_Renderer *renderer, int x, int y) {
+    int windowWidth = 0;
+    int windowHeight = 0;
+    int outputWidth = 0;
+    int outputHeight = 0;
+    SDL_GetWindowSize(SDL_RenderGetWindow(renderer), &windowWidth, &windowHeight);
+    SDL_GetRendererOutputSize(renderer, &outputWidth, &outputHeight);
+
+    SDL_Point point = {x, y};
+    if (windowWidth > 0 && windowHeight > 0) {
+        point.x = x * outputWidth / windowWidth;
+        point.y = y * outputHeight / windowHeight;
+    }
+
+    return point;
+}
@@ -0,0 +1,66 @@
+#ifndef CIV_TILEPICKER_H
+#define CIV_TILEPICKER_H
+
+#include <SDL.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AssetPack.h"
+#include "Tile.h"
+
+const int PICK_NONE = -1;
+// Pixels at or above this alpha count as part of the sprite
+const uint8_t PICK_ALPHA_THRESHOLD = 128;
+
+// One bit per pixel of a sprite clip, set where the sprite is opaque
+class AlphaMask {
+public:
+    AlphaMask();
+
+    void build(const uint8_t *rgba, int pitch, const SDL_Rect &clip);
+
+    // x and y are relative to the clip's top left
+    bool test(int x, int y) const;
+
+private:
+    int width;
+    int height;
+    int stride;
+    std::vector<uint64_t> bits;
+};
+
+struct PickResult {
+    // Index into the tile list, or PICK_NONE
+    int tile;
+    // Index into the tile's layers, or PICK_NONE for the tile sprite itself
+    int layer;
+};
+
+// Maps a point on the map to the topmost sprite under it. Masks are built
+// once per sprite sheet clip at load time; a pick then tests only the
+// tiles whose sprites can overlap the point, found by grid math, so it
+// costs the same on any map size.
+class TilePicker {
+public:
+    // Builds masks for the clips from the sheet in the pack, or from the
+    // loose file if the pack does not have it
+    bool loadMasks(AssetPack *pack, std::string path, const SDL_Rect clips[], int count);
+
+    // x and y are relative to the sprite's position. Clips without a mask
+    // are treated as solid rectangles.
+    bool hitTest(const SDL_Rect &clip, int x, int y) const;
+
+    // tiles are in row-major order, columns wide, laid out as in main.cpp
+    PickResult pick(const std::vector<Tile> &tiles, int columns, int x, int y) const;
+
+private:
+    std::unordered_map<uint32_t, AlphaMask> masks;
+};
+
+// Converts window coordinates from mouse events to renderer pixels, which
+// differ on high-DPI displays
+SDL_Point windowToRenderer(SDL_Renderer *renderer, int x, int y);
+
+#endif
@@ -0,0 +1,13 @@
+#include "UnitSystems.h"
+
+void resetMovement(EntityManager *entities) {
+    entities->parallelForEach<Movement>([](Entity, Movement &movement) {
+        movement.moves = movement.maxMoves;
+    });
+}
+
+void healUnits(EntityManager *entities, int amount) {
+    entities->parallelForEach<Health>([amount](Entity, Health &health) {
+        health.hp = health.hp + amount < health.maxHp ? health.hp + amount : health.maxHp;
+    });
+}
@@ -0,0 +1,13 @@
+#ifndef CIV_UNITSYSTEMS_H
+#define CIV_UNITSYSTEMS_H
+
+#include "EntityManager.h"
+
+// Start-of-turn systems. Each one is a single pass over the matching
+// component columns and is safe to run across worker threads.
+
+void resetMovement(EntityManager *entities);
+
+void healUnits(EntityManager *entities, int amount);
+
+#endif
@@ -0,0 +1,89 @@
+#include "WorkerPool.h"
+
+static thread_local bool tInsideTask = false;
+
+WorkerPool &WorkerPool::instance() {
+    static WorkerPool pool;
+    return pool;
+}
+
+WorkerPool::WorkerPool() :
+        task(nullptr),
+        context(nullptr),
+        helpers(0),
+        pending(0),
+        generation(0),
+        stopping(false) {
+
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
+
+void WorkerPool::run(unsigned threadCount, void (*task)(void *), void *context) {
+    // A nested loop would wait on workers that are busy running its caller
+    if (threadCount <= 1 || tInsideTask) {
+        task(context);
+        return;
+    }
+
+    std::lock_guard<std::mutex> serial(runMutex);
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (threads.size() < threadCount - 1) {
+        threads.emplace_back(&WorkerPool::workerLoop, this, (unsigned) threads.size());
+    }
+
+    this->task = task;
+    this->context = context;
+    helpers = threadCount - 1;
+    pending = helpers;
+    generation++;
+    lock.unlock();
+    wake.notify_all();
+
+    tInsideTask = true;
+    task(context);
+    tInsideTask = false;
+
+    lock.lock();
+    finished.wait(lock, [this]() { return pending == 0; });
+}
+
+void WorkerPool::workerLoop(unsigned index) {
+    tInsideTask = true;
+    uint64_t seen = 0;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [this, seen]() { return stopping || generation != seen; });
+        if (stopping) {
+            return;
+        }
+
+        // run() waits for every helper, so a helper cannot miss a generation
+        seen = generation;
+        if (index >= helpers) {
+            continue;
+        }
+
+        void (*job)(void *) = task;
+        void *jobContext = context;
+        lock.unlock();
+        job(jobContext);
+        lock.lock();
+
+        if (--pending == 0) {
+            finished.notify_one();
+        }
+    }
+}
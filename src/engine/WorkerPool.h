@@ -0,0 +1,46 @@
+#ifndef CIV_WORKERPOOL_H
+#define CIV_WORKERPOOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Worker threads kept alive between parallel loops. Starting a thread
+// allocates its state and, on first use, its thread-local frame arena, so
+// creating workers per loop would cost both every turn; here a loop only
+// wakes threads that already exist. Workers are started the first time a
+// loop asks for that many.
+class WorkerPool {
+public:
+    static WorkerPool &instance();
+
+    ~WorkerPool();
+
+    // Calls task(context) on the calling thread and on threadCount - 1
+    // workers, returning once every call has returned. Runs inline when
+    // called from inside a task.
+    void run(unsigned threadCount, void (*task)(void *), void *context);
+
+private:
+    WorkerPool();
+
+    void workerLoop(unsigned index);
+
+    // Held for a whole run so only one loop uses the workers at a time
+    std::mutex runMutex;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    std::vector<std::thread> threads;
+    void (*task)(void *);
+    void *context;
+    // Workers taking part in the current run, and how many are still in it
+    unsigned helpers;
+    unsigned pending;
+    uint64_t generation;
+    bool stopping;
+};
+
+#endif
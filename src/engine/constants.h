@@ -13,11 +13,17 @@ const int NUM_ROWS = 9;
 const int NUM_COLS = 16;
 const int NUM_TILES = NUM_ROWS * NUM_COLS;
 const int NUM_ICONS = NUM_TILES;
+const int NUM_PLAYERS = 4;
+
+// GPU memory the texture residency manager tries to stay under
+const unsigned long long TEXTURE_BUDGET_BYTES = 256ull * 1024 * 1024;
 
 const int BUTTON_WIDTH = 670;
 const int BUTTON_HEIGHT = 162;
 const int TOTAL_BUTTONS = 4;
 
+// Terrain tile ids are terrain type * 4 + variant; per-terrain data lives
+// in world/TerrainRegistry.h
 const int GRASS1_TILE = 0;
 const int GRASS2_TILE = 1;
 const int GRASS3_TILE = 2;
@@ -50,6 +56,7 @@ const int HILLS1_TILE = 28;
 const int HILLS2_TILE = 29;
 const int HILLS3_TILE = 30;
 const int HILLS4_TILE = 31;
+const int NUM_TERRAIN_CLIPS = 32;
 
 const int ICON_WIDTH = 72;
 const int ICON_HEIGHT = 78;
@@ -2,32 +2,49 @@
 #include <SDL_image.h>
 #include <SDL_ttf.h>
 #include <cstdio>
+#include <cstring>
 #include <string>
-#include <sstream>
 
+#include "engine/AllocationTracker.h"
+#include "engine/AssetPack.h"
+#include "engine/BorderOverlay.h"
 #include "engine/Texture.h"
+#include "engine/TextureResidency.h"
+#include "engine/TilePicker.h"
 #include "engine/Timer.h"
 #include "engine/Tile.h"
 #include "engine/constants.h"
 #include "engine/Button.h"
+#include "engine/FrameArena.h"
+#include "engine/FrameScheduler.h"
+#include "engine/RenderStats.h"
+#include "engine/StatsOverlay.h"
+#include "world/GameMap.h"
+#include "world/InfluenceMap.h"
+#include "world/TerrainRegistry.h"
 
 bool init();
 bool loadMedia();
 void close();
+void foundCities(GameMap *map, InfluenceMap *territory);
 
 SDL_Window *gWindow = nullptr;
 SDL_Renderer *gRenderer = nullptr;
 TTF_Font *gFont = nullptr;
-SDL_Rect gTileClips[32];
+TTF_Font *gStatsFont = nullptr;
+AssetPack gAssetPack;
+SDL_Rect gTileClips[NUM_TERRAIN_CLIPS];
 SDL_Rect gIconClips[1];
 SDL_Rect gButtonClips[1];
-Texture gSpritesTexture;
+TilePicker gPicker;
+TextureResidency *gTextures = nullptr;
+Texture *gSpritesTexture = nullptr;
 Texture gFPSTextTexture;
 
 bool init() {
     bool success = true;
 
-    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) < 0) {
         printf("SDL could not initialize! %s\n", SDL_GetError());
         success = false;
     } else {
@@ -71,188 +88,61 @@ bool init() {
     return success;
 }
 
+TTF_Font *loadFont(std::string path, int size) {
+    if (gAssetPack.isOpen()) {
+        const AssetPackEntry *entry = gAssetPack.find(path);
+        if (entry != nullptr && entry->type == ASSET_TYPE_FONT) {
+            // The pack stays mapped until close(), so the font can read from it directly
+            return TTF_OpenFontRW(SDL_RWFromConstMem(gAssetPack.getData(entry), (int) entry->size),
+                                  1,
+                                  size);
+        }
+    }
+
+    return TTF_OpenFont(path.c_str(), size);
+}
+
 bool loadMedia() {
+    AllocationScope scope(ALLOC_ASSETS);
     bool success = true;
 
-    gFont = TTF_OpenFont("assets/fonts/georgia/georgia bold.ttf", 64);
+    if (!gAssetPack.open("assets/civ.pack")) {
+        printf("Asset pack not found, loading loose assets\n");
+    }
+
+    gFont = loadFont("assets/fonts/georgia/georgia bold.ttf", 64);
     if (gFont == nullptr) {
         printf("Failed to load lazy font! SDL_ttf Error: %s\n", TTF_GetError());
         success = false;
     }
 
-    if (!gSpritesTexture.loadFromFile(
-            gRenderer,
-            "assets/images/tiles/painted_terrain_tiles_basic_256x384_sheet.png")) {
+    gStatsFont = loadFont("assets/fonts/georgia/georgia bold.ttf", 24);
+    if (gStatsFont == nullptr) {
+        printf("Failed to load stats font! SDL_ttf Error: %s\n", TTF_GetError());
+        success = false;
+    }
+
+    gTextures = new TextureResidency(gRenderer, TEXTURE_BUDGET_BYTES);
+    gTextures->setAssetPack(&gAssetPack);
+
+    std::string spriteSheet = "assets/images/tiles/painted_terrain_tiles_basic_256x384_sheet.png";
+    gSpritesTexture = gTextures->acquire(spriteSheet);
+    if (gSpritesTexture == nullptr) {
         printf("Failed to load sprite sheet texture!\n");
 
         success = false;
     }
 
-    // Grass tiles
-    gTileClips[GRASS1_TILE].x = TILE_WIDTH * 0;
-    gTileClips[GRASS1_TILE].y = 0;
-    gTileClips[GRASS1_TILE].w = TILE_WIDTH;
-    gTileClips[GRASS1_TILE].h = TILE_HEIGHT;
-
-    gTileClips[GRASS2_TILE].x = TILE_WIDTH * 1;
-    gTileClips[GRASS2_TILE].y = 0;
-    gTileClips[GRASS2_TILE].w = TILE_WIDTH;
-    gTileClips[GRASS2_TILE].h = TILE_HEIGHT;
-
-    gTileClips[GRASS3_TILE].x = TILE_WIDTH * 2;
-    gTileClips[GRASS3_TILE].y = 0;
-    gTileClips[GRASS3_TILE].w = TILE_WIDTH;
-    gTileClips[GRASS3_TILE].h = TILE_HEIGHT;
-
-    gTileClips[GRASS4_TILE].x = TILE_WIDTH * 3;
-    gTileClips[GRASS4_TILE].y = 0;
-    gTileClips[GRASS4_TILE].w = TILE_WIDTH;
-    gTileClips[GRASS4_TILE].h = TILE_HEIGHT;
-
-    // Water tiles
-    gTileClips[WATER1_TILE].x = TILE_WIDTH * 4;
-    gTileClips[WATER1_TILE].y = 0;
-    gTileClips[WATER1_TILE].w = TILE_WIDTH;
-    gTileClips[WATER1_TILE].h = TILE_HEIGHT;
-
-    gTileClips[WATER2_TILE].x = TILE_WIDTH * 5;
-    gTileClips[WATER2_TILE].y = 0;
-    gTileClips[WATER2_TILE].w = TILE_WIDTH;
-    gTileClips[WATER2_TILE].h = TILE_HEIGHT;
-
-    gTileClips[WATER3_TILE].x = TILE_WIDTH * 6;
-    gTileClips[WATER3_TILE].y = 0;
-    gTileClips[WATER3_TILE].w = TILE_WIDTH;
-    gTileClips[WATER3_TILE].h = TILE_HEIGHT;
-
-    gTileClips[WATER4_TILE].x = TILE_WIDTH * 7;
-    gTileClips[WATER4_TILE].y = 0;
-    gTileClips[WATER4_TILE].w = TILE_WIDTH;
-    gTileClips[WATER4_TILE].h = TILE_HEIGHT;
-
-    // Mountain tiles
-    gTileClips[MOUNTAIN1_TILE].x = TILE_WIDTH * 0;
-    gTileClips[MOUNTAIN1_TILE].y = TILE_HEIGHT;
-    gTileClips[MOUNTAIN1_TILE].w = TILE_WIDTH;
-    gTileClips[MOUNTAIN1_TILE].h = TILE_HEIGHT;
-
-    gTileClips[MOUNTAIN2_TILE].x = TILE_WIDTH * 1;
-    gTileClips[MOUNTAIN2_TILE].y = TILE_HEIGHT;
-    gTileClips[MOUNTAIN2_TILE].w = TILE_WIDTH;
-    gTileClips[MOUNTAIN2_TILE].h = TILE_HEIGHT;
-
-    gTileClips[MOUNTAIN3_TILE].x = TILE_WIDTH * 2;
-    gTileClips[MOUNTAIN3_TILE].y = TILE_HEIGHT;
-    gTileClips[MOUNTAIN3_TILE].w = TILE_WIDTH;
-    gTileClips[MOUNTAIN3_TILE].h = TILE_HEIGHT;
-
-    gTileClips[MOUNTAIN4_TILE].x = TILE_WIDTH * 3;
-    gTileClips[MOUNTAIN4_TILE].y = TILE_HEIGHT;
-    gTileClips[MOUNTAIN4_TILE].w = TILE_WIDTH;
-    gTileClips[MOUNTAIN4_TILE].h = TILE_HEIGHT;
-
-    gTileClips[DESERT1_TILE].x = TILE_WIDTH * 4;
-    gTileClips[DESERT1_TILE].y = TILE_HEIGHT;
-    gTileClips[DESERT1_TILE].w = TILE_WIDTH;
-    gTileClips[DESERT1_TILE].h = TILE_HEIGHT;
-
-    gTileClips[DESERT2_TILE].x = TILE_WIDTH * 5;
-    gTileClips[DESERT2_TILE].y = TILE_HEIGHT;
-    gTileClips[DESERT2_TILE].w = TILE_WIDTH;
-    gTileClips[DESERT2_TILE].h = TILE_HEIGHT;
-
-    gTileClips[DESERT3_TILE].x = TILE_WIDTH * 6;
-    gTileClips[DESERT3_TILE].y = TILE_HEIGHT;
-    gTileClips[DESERT3_TILE].w = TILE_WIDTH;
-    gTileClips[DESERT3_TILE].h = TILE_HEIGHT;
-
-    gTileClips[DESERT4_TILE].x = TILE_WIDTH * 7;
-    gTileClips[DESERT4_TILE].y = TILE_HEIGHT;
-    gTileClips[DESERT4_TILE].w = TILE_WIDTH;
-    gTileClips[DESERT4_TILE].h = TILE_HEIGHT;
-
-    gTileClips[FOREST1_TILE].x = TILE_WIDTH * 0;
-    gTileClips[FOREST1_TILE].y = TILE_HEIGHT * 2;
-    gTileClips[FOREST1_TILE].w = TILE_WIDTH;
-    gTileClips[FOREST1_TILE].h = TILE_HEIGHT;
-
-    gTileClips[FOREST2_TILE].x = TILE_WIDTH * 1;
-    gTileClips[FOREST2_TILE].y = TILE_HEIGHT * 2;
-    gTileClips[FOREST2_TILE].w = TILE_WIDTH;
-    gTileClips[FOREST2_TILE].h = TILE_HEIGHT;
-
-    gTileClips[FOREST3_TILE].x = TILE_WIDTH * 2;
-    gTileClips[FOREST3_TILE].y = TILE_HEIGHT * 2;
-    gTileClips[FOREST3_TILE].w = TILE_WIDTH;
-    gTileClips[FOREST3_TILE].h = TILE_HEIGHT;
-
-    gTileClips[FOREST4_TILE].x = TILE_WIDTH * 3;
-    gTileClips[FOREST4_TILE].y = TILE_HEIGHT * 2;
-    gTileClips[FOREST4_TILE].w = TILE_WIDTH;
-    gTileClips[FOREST4_TILE].h = TILE_HEIGHT;
-
-    gTileClips[DIRT1_TILE].x = TILE_WIDTH * 0;
-    gTileClips[DIRT1_TILE].y = TILE_HEIGHT * 3;
-    gTileClips[DIRT1_TILE].w = TILE_WIDTH;
-    gTileClips[DIRT1_TILE].h = TILE_HEIGHT;
-
-    gTileClips[DIRT2_TILE].x = TILE_WIDTH * 1;
-    gTileClips[DIRT2_TILE].y = TILE_HEIGHT * 3;
-    gTileClips[DIRT2_TILE].w = TILE_WIDTH;
-    gTileClips[DIRT2_TILE].h = TILE_HEIGHT;
-
-    gTileClips[DIRT3_TILE].x = TILE_WIDTH * 2;
-    gTileClips[DIRT3_TILE].y = TILE_HEIGHT * 3;
-    gTileClips[DIRT3_TILE].w = TILE_WIDTH;
-    gTileClips[DIRT3_TILE].h = TILE_HEIGHT;
-
-    gTileClips[DIRT4_TILE].x = TILE_WIDTH * 3;
-    gTileClips[DIRT4_TILE].y = TILE_HEIGHT * 3;
-    gTileClips[DIRT4_TILE].w = TILE_WIDTH;
-    gTileClips[DIRT4_TILE].h = TILE_HEIGHT;
-
-    gTileClips[MARSH1_TILE].x = TILE_WIDTH * 4;
-    gTileClips[MARSH1_TILE].y = TILE_HEIGHT * 2;
-    gTileClips[MARSH1_TILE].w = TILE_WIDTH;
-    gTileClips[MARSH1_TILE].h = TILE_HEIGHT;
-
-    gTileClips[MARSH2_TILE].x = TILE_WIDTH * 5;
-    gTileClips[MARSH2_TILE].y = TILE_HEIGHT * 2;
-    gTileClips[MARSH2_TILE].w = TILE_WIDTH;
-    gTileClips[MARSH2_TILE].h = TILE_HEIGHT;
-
-    gTileClips[MARSH3_TILE].x = TILE_WIDTH * 6;
-    gTileClips[MARSH3_TILE].y = TILE_HEIGHT * 2;
-    gTileClips[MARSH3_TILE].w = TILE_WIDTH;
-    gTileClips[MARSH3_TILE].h = TILE_HEIGHT;
-
-    gTileClips[MARSH4_TILE].x = TILE_WIDTH * 7;
-    gTileClips[MARSH4_TILE].y = TILE_HEIGHT * 2;
-    gTileClips[MARSH4_TILE].w = TILE_WIDTH;
-    gTileClips[MARSH4_TILE].h = TILE_HEIGHT;
-
-    gTileClips[HILLS1_TILE].x = TILE_WIDTH * 0;
-    gTileClips[HILLS1_TILE].y = TILE_HEIGHT * 4;
-    gTileClips[HILLS1_TILE].w = TILE_WIDTH;
-    gTileClips[HILLS1_TILE].h = TILE_HEIGHT;
-
-    gTileClips[HILLS2_TILE].x = TILE_WIDTH * 1;
-    gTileClips[HILLS2_TILE].y = TILE_HEIGHT * 4;
-    gTileClips[HILLS2_TILE].w = TILE_WIDTH;
-    gTileClips[HILLS2_TILE].h = TILE_HEIGHT;
-
-    gTileClips[HILLS3_TILE].x = TILE_WIDTH * 2;
-    gTileClips[HILLS3_TILE].y = TILE_HEIGHT * 4;
-    gTileClips[HILLS3_TILE].w = TILE_WIDTH;
-    gTileClips[HILLS3_TILE].h = TILE_HEIGHT;
-
-    gTileClips[HILLS4_TILE].x = TILE_WIDTH * 3;
-    gTileClips[HILLS4_TILE].y = TILE_HEIGHT * 4;
-    gTileClips[HILLS4_TILE].w = TILE_WIDTH;
-    gTileClips[HILLS4_TILE].h = TILE_HEIGHT;
-
-    gIconClips[FOOD_ICON].x = 7 + TILE_WIDTH * 8 + ICON_WIDTH * 0;
-    gIconClips[FOOD_ICON].y = ICON_HEIGHT * 0;
+    for (int tile = 0; tile < NUM_TERRAIN_CLIPS; tile++) {
+        gTileClips[tile].x = terrainClipX(tile);
+        gTileClips[tile].y = terrainClipY(tile);
+        gTileClips[tile].w = TILE_WIDTH;
+        gTileClips[tile].h = TILE_HEIGHT;
+    }
+
+    // The apple sits to the right of the button on the sprite sheet
+    gIconClips[FOOD_ICON].x = 2302;
+    gIconClips[FOOD_ICON].y = 2;
     gIconClips[FOOD_ICON].w = ICON_WIDTH;
     gIconClips[FOOD_ICON].h = ICON_HEIGHT;
 
@@ -261,14 +151,27 @@ bool loadMedia() {
     gButtonClips[MAIN_BUTTON].w = BUTTON_WIDTH;
     gButtonClips[MAIN_BUTTON].h = BUTTON_HEIGHT;
 
+    if (!gPicker.loadMasks(&gAssetPack, spriteSheet, gTileClips, NUM_TERRAIN_CLIPS) ||
+        !gPicker.loadMasks(&gAssetPack, spriteSheet, gIconClips, 1)) {
+        printf("Failed to build sprite masks, picking falls back to rectangles\n");
+    }
+
     return success;
 }
 
 void close() {
     gFPSTextTexture.free();
 
+    delete gTextures;
+    gTextures = nullptr;
+    gSpritesTexture = nullptr;
+
     TTF_CloseFont(gFont);
     gFont = nullptr;
+    TTF_CloseFont(gStatsFont);
+    gStatsFont = nullptr;
+
+    gAssetPack.close();
 
     SDL_DestroyRenderer(gRenderer);
     SDL_DestroyWindow(gWindow);
@@ -280,7 +183,21 @@ void close() {
     SDL_Quit();
 }
 
-int main(__unused int argc, __unused char *args[]) {
+void foundCities(GameMap *map, InfluenceMap *territory) {
+    territory->clearSources();
+
+    for (int player = 0; player < NUM_PLAYERS; player++) {
+        for (int attempt = 0; attempt < 64; attempt++) {
+            if (territory->addSource(rand() % map->getWidth(), // NOLINT(cert-msc30-c, cert-msc50-cpp)
+                                     rand() % map->getHeight(), // NOLINT(cert-msc30-c, cert-msc50-cpp)
+                                     player) >= 0) {
+                break;
+            }
+        }
+    }
+}
+
+int main(int argc, char *args[]) {
     if (!init()) {
         printf("Failed to initialize!\n");
     } else {
@@ -292,26 +209,34 @@ int main(__unused int argc, __unused char *args[]) {
 
 
             Button button = Button(gRenderer,
-                                   &gSpritesTexture,
+                                   gSpritesTexture,
                                    50,
                                    50,
                                    gButtonClips[MAIN_BUTTON]);
 
             srand((unsigned) time(0));
+            GameMap gameMap(NUM_COLS, NUM_ROWS);
+            gameMap.generate((unsigned) rand());
+
+            InfluenceMap territory(&gameMap);
+            BorderOverlay borders(gRenderer, &territory);
+            foundCities(&gameMap, &territory);
+
             std::vector<Tile> tiles;
+            tiles.reserve((size_t) NUM_COLS * NUM_ROWS);
             Tile* icons = (Tile*)malloc(sizeof(Tile) * NUM_ICONS);
 
             for (int row = 0; row < NUM_ROWS; row++) {
                 for (int col = 0; col < NUM_COLS; col++) {
                     int index = row * NUM_COLS + col;
-                    int randClip = rand() % 32;
                     tiles.emplace_back(gRenderer,
-                                        &gSpritesTexture,
+                                        gSpritesTexture,
                                         col * TILE_WIDTH,
                                         row * TILE_SIZE - TILE_SIZE / 2,
-                                        gTileClips[randClip]);
+                                        gTileClips[gameMap.getTerrain(col, row)],
+                                        gameMap.getTerrain(col, row));
 //                    icons[index] = Tile(gRenderer,
-//                                    &gSpritesTexture,
+//                                    gSpritesTexture,
 //                                    col * TILE_WIDTH,
 //                                    row * TILE_SIZE - TILE_SIZE / 2,
 //                                    gIconClips[FOOD_ICON]);
@@ -320,7 +245,7 @@ int main(__unused int argc, __unused char *args[]) {
 
 //            Tile* icons = (Tile*)malloc(sizeof(Tile) * NUM_ICONS);
 //            icons[0] = Tile(gRenderer,
-//                            &gSpritesTexture,
+//                            gSpritesTexture,
 //                            500,
 //                            500,
 //                            gIconClips[FOOD_ICON]);
@@ -328,55 +253,127 @@ int main(__unused int argc, __unused char *args[]) {
             SDL_Event e;
             SDL_Color textColor = {71, 26, 13, 255};
 
-            Timer fpsTimer;
             Timer capTimer;
-            std::stringstream timeText;
-            int countedFrames = 0;
-            fpsTimer.start();
+            FrameArena &frameArena = FrameArena::local();
+            RenderStats &stats = RenderStats::instance();
+            StatsOverlay statsOverlay(gRenderer, gStatsFont);
+            FrameScheduler scheduler;
+            int statsTimer = 0;
+            PickResult hovered = {PICK_NONE, PICK_NONE};
+            SDL_Rect view = {0, 0, SCREEN_WIDTH, SCREEN_HEIGHT};
+
+            scheduler.setContinuous(argc > 1 && strcmp(args[1], "--continuous") == 0);
+
+            // The label never changes, so render it once rather than every frame
+            if (!gFPSTextTexture.loadFromRenderedText(gRenderer,
+                                                      gFont,
+                                                      "Regenerate Map",
+                                                      textColor)) {
+                printf("Unable to render FPS texture!\n");
+            }
 
-            while (!quit) {
-                capTimer.start();
+            // Loading is not part of the first frame; after this RenderStats
+            // opens each frame's allocation window as the previous one ends
+            AllocationTracker::instance().beginFrame();
 
-                while (SDL_PollEvent(&e) != 0) {
-                    if (e.type == SDL_QUIT) {
-                        quit = true;
+            while (!quit) {
+                bool wasIdle = scheduler.isIdle();
+                bool haveEvent = scheduler.waitEvent(&e);
+
+                while (haveEvent) {
+                    AllocationScope eventScope(ALLOC_UI);
+
+                    if (!scheduler.handleEvent(&e)) {
+                        if (e.type == SDL_QUIT) {
+                            quit = true;
+                        } else if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F3 && !e.key.repeat) {
+                            statsOverlay.toggle();
+
+                            // Keep the overlay current without forcing 60 fps while it is open
+                            if (statsOverlay.isVisible()) {
+                                statsTimer = scheduler.addTimer(STATS_OVERLAY_REFRESH_MS, [&scheduler]() {
+                                    scheduler.requestRedraw();
+                                    return true;
+                                });
+                            } else {
+                                scheduler.removeTimer(statsTimer);
+                            }
+                        } else if (e.type == SDL_MOUSEMOTION) {
+                            SDL_Point point = windowToRenderer(gRenderer, e.motion.x, e.motion.y);
+                            PickResult hit = gPicker.pick(tiles, gameMap.getWidth(), point.x + view.x, point.y + view.y);
+
+                            // Motion alone does not wake the loop, only a change of hovered tile
+                            if (hit.tile != hovered.tile || hit.layer != hovered.layer) {
+                                hovered = hit;
+                                scheduler.requestRedraw();
+                            }
+                        }
+
+                        if (button.handleEvent(&e, &gameMap, &tiles, gTileClips, gIconClips)) {
+                            foundCities(&gameMap, &territory);
+                            hovered.tile = PICK_NONE;
+                            hovered.layer = PICK_NONE;
+                        }
                     }
 
-                    button.handleEvent(&e, &tiles, gTileClips);
+                    haveEvent = SDL_PollEvent(&e) != 0;
                 }
 
-                float avgFPS = countedFrames / (fpsTimer.getTicks() / 1000.f);
-                if (avgFPS > 2000000) {
-                    avgFPS = 0;
+                if (quit || !scheduler.needsFrame()) {
+                    continue;
                 }
 
-                timeText.str("Regenerate Map");
+                AllocationScope renderScope(ALLOC_RENDER);
 
-                if (!gFPSTextTexture.loadFromRenderedText(gRenderer,
-                                                          gFont,
-                                                          timeText.str(),
-                                                          textColor)) {
-                    printf("Unable to render FPS texture!\n");
+                if (wasIdle) {
+                    stats.skipInterval();
                 }
 
+                capTimer.start();
+                stats.beginFrame();
+                gTextures->beginFrame();
+
                 SDL_SetRenderDrawColor(gRenderer, 0xFF, 0xFF, 0xFF, 0xFF);
                 SDL_RenderClear(gRenderer);
+                SDL_GetRendererOutputSize(gRenderer, &view.w, &view.h);
+
+                // Draw list of visible tiles, rebuilt in the frame arena each frame
+                Tile **drawList = frameArena.allocateArray<Tile *>(tiles.size());
+                size_t drawCount = 0;
+                for (auto &tile : tiles) {
+                    if (tile.isVisible(view)) {
+                        drawList[drawCount++] = &tile;
+                    } else {
+                        stats.countCulled(1);
+                    }
+                }
 
-                for (auto tile: tiles) {
-                    tile.render();
+                for (size_t i = 0; i < drawCount; i++) {
+                    drawList[i]->render();
                 }
 
+                if (hovered.tile != PICK_NONE) {
+                    tiles[hovered.tile].renderHighlight();
+                }
+
+                borders.render();
+
 //                for (int i = 0; i < NUM_ICONS; i++) {
 //                    icons[i].render();
 //                }
 
                 button.render();
                 gFPSTextTexture.render(gRenderer, 118, 86);
+                statsOverlay.render(view.w - STATS_HISTORY * 2 - 48, 24);
                 SDL_RenderPresent(gRenderer);
-                ++countedFrames;
+                stats.endFrame();
+                scheduler.frameRendered();
+                frameArena.reset();
 
+                // Only pace frames while something is still moving; an idle
+                // loop goes straight back to waiting for the next event
                 int frameTicks = capTimer.getTicks();
-                if (frameTicks < SCREEN_TICK_PER_FRAME) {
+                if (!scheduler.isIdle() && frameTicks < SCREEN_TICK_PER_FRAME) {
                     SDL_Delay(SCREEN_TICK_PER_FRAME - frameTicks);
                 }
             }
@@ -385,5 +382,10 @@ int main(__unused int argc, __unused char *args[]) {
 
     close();
 
+    if (AllocationTracker::isEnabled()) {
+        printf("Allocations:\n");
+        AllocationTracker::instance().printSubsystems();
+    }
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,318 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "engine/AllocationTracker.h"
+#include "world/GameMap.h"
+#include "world/Simulation.h"
+
+// Headless driver for the world simulation: no window, no renderer, just
+// turns as fast as the CPU allows.
+//
+// Usage: civ_sim [--map file] [--width N] [--height N] [--seed N]
+//                [--players N] [--units N] [--cities N] [--turns N]
+//                [--save file] [--autosave file] [--autosave-every N]
+//                [--alloc-budget N] [--verify-territory N]
+//
+// With --alloc-budget (in a CIV_TRACK_ALLOCATIONS build) the run fails if
+// any turn after the warm-up allocates more than N times. --verify-territory
+// makes N random city and terrain edits before the turns and fails if the
+// incremental territory ever differs from a full rebuild.
+
+// Turns that fill caches and arenas before allocations count against the budget
+static const int ALLOC_WARMUP_TURNS = 20;
+
+static void usage() {
+    printf("Usage: civ_sim [--map file] [--width N] [--height N] [--seed N]\n"
+           "               [--players N] [--units N] [--cities N] [--turns N]\n"
+           "               [--save file] [--autosave file] [--autosave-every N]\n"
+           "               [--alloc-budget N] [--verify-territory N]\n");
+}
+
+// Returns the number of tiles where the incremental result and a full
+// rebuild from the same sources disagree
+static int diffTerritory(const InfluenceMap &territory) {
+    InfluenceMap rebuilt(territory);
+    rebuilt.rebuild();
+
+    int mismatches = 0;
+    for (int y = 0; y < territory.getHeight(); y++) {
+        for (int x = 0; x < territory.getWidth(); x++) {
+            if (territory.getOwner(x, y) != rebuilt.getOwner(x, y) ||
+                territory.getDistance(x, y) != rebuilt.getDistance(x, y) ||
+                territory.getSource(x, y) != rebuilt.getSource(x, y)) {
+                mismatches++;
+            }
+        }
+    }
+
+    return mismatches;
+}
+
+// Applies random captures, razes, new cities and terrain changes, checking
+// the territory against a rebuild after each. Returns false on a mismatch.
+static bool verifyTerritory(Simulation *simulation, std::vector<int> cities, int players, int edits, unsigned seed) {
+    GameMap *map = simulation->getMap();
+    std::mt19937 rng(seed);
+
+    for (int i = 0; i < edits; i++) {
+        int x = (int) (rng() % map->getWidth());
+        int y = (int) (rng() % map->getHeight());
+        int player = (int) (rng() % std::max(1, players));
+        const char *edit;
+
+        switch (rng() % 4) {
+            case 0:
+                if (!cities.empty()) {
+                    simulation->captureCity(cities[rng() % cities.size()], player);
+                }
+                edit = "capture";
+                break;
+            case 1:
+                if (!cities.empty()) {
+                    size_t index = rng() % cities.size();
+                    simulation->razeCity(cities[index]);
+                    cities.erase(cities.begin() + index);
+                }
+                edit = "raze";
+                break;
+            case 2: {
+                int city = simulation->foundCity(x, y, player);
+                if (city >= 0) {
+                    cities.push_back(city);
+                }
+                edit = "found";
+                break;
+            }
+            default:
+                simulation->setTerrain(x, y, (int) (rng() % NUM_TERRAIN_CLIPS));
+                edit = "terrain";
+                break;
+        }
+
+        int mismatches = diffTerritory(*simulation->getTerritory());
+        if (mismatches > 0) {
+            printf("Territory check failed after edit %d (%s at %d,%d): %d tiles differ from a rebuild\n",
+                   i, edit, x, y, mismatches);
+            return false;
+        }
+    }
+
+    printf("Territory check: %d edits, incremental updates match a full rebuild\n", edits);
+    return true;
+}
+
+int main(int argc, char *args[]) {
+    const char *mapPath = nullptr;
+    const char *savePath = nullptr;
+    const char *autosavePath = nullptr;
+    int autosaveEvery = 50;
+    int width = 128;
+    int height = 80;
+    unsigned seed = 1;
+    int players = 8;
+    int unitsPerPlayer = 1000;
+    int citiesPerPlayer = 4;
+    int turns = 500;
+    long long allocationBudget = -1;
+    int territoryEdits = 0;
+
+    for (int i = 1; i < argc; i++) {
+        bool hasValue = i + 1 < argc;
+
+        if (strcmp(args[i], "--map") == 0 && hasValue) {
+            mapPath = args[++i];
+        } else if (strcmp(args[i], "--save") == 0 && hasValue) {
+            savePath = args[++i];
+        } else if (strcmp(args[i], "--autosave") == 0 && hasValue) {
+            autosavePath = args[++i];
+        } else if (strcmp(args[i], "--autosave-every") == 0 && hasValue) {
+            autosaveEvery = atoi(args[++i]);
+        } else if (strcmp(args[i], "--alloc-budget") == 0 && hasValue) {
+            allocationBudget = atoll(args[++i]);
+        } else if (strcmp(args[i], "--verify-territory") == 0 && hasValue) {
+            territoryEdits = atoi(args[++i]);
+        } else if (strcmp(args[i], "--width") == 0 && hasValue) {
+            width = atoi(args[++i]);
+        } else if (strcmp(args[i], "--height") == 0 && hasValue) {
+            height = atoi(args[++i]);
+        } else if (strcmp(args[i], "--seed") == 0 && hasValue) {
+            seed = (unsigned) strtoul(args[++i], nullptr, 10);
+        } else if (strcmp(args[i], "--players") == 0 && hasValue) {
+            players = atoi(args[++i]);
+        } else if (strcmp(args[i], "--units") == 0 && hasValue) {
+            unitsPerPlayer = atoi(args[++i]);
+        } else if (strcmp(args[i], "--cities") == 0 && hasValue) {
+            citiesPerPlayer = atoi(args[++i]);
+        } else if (strcmp(args[i], "--turns") == 0 && hasValue) {
+            turns = atoi(args[++i]);
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    if (width <= 0 || height <= 0) {
+        usage();
+        return 1;
+    }
+
+    // Territory stores owners as bytes, one value of which means unowned
+    if (players <= 0 || players > INFLUENCE_NO_OWNER) {
+        printf("--players must be between 1 and %d\n", INFLUENCE_NO_OWNER);
+        return 1;
+    }
+
+    GameMap map(width, height);
+    if (mapPath != nullptr) {
+        if (!map.load(mapPath)) {
+            return 1;
+        }
+    } else {
+        map.generate(seed);
+    }
+
+    Simulation simulation(&map, seed);
+    int units = simulation.spawnUnits(players, unitsPerPlayer);
+
+    printf("Map %dx%d, %d players, %d units\n", map.getWidth(), map.getHeight(), players, units);
+
+    // Found cities one at a time, as the game does, then compare the
+    // incremental territory updates with a single full rebuild
+    InfluenceMap *territory = simulation.getTerritory();
+    std::mt19937 placement(seed);
+    std::vector<int> cities;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int player = 0; player < players; player++) {
+        for (int i = 0; i < citiesPerPlayer; i++) {
+            for (int attempt = 0; attempt < 64; attempt++) {
+                int city = simulation.foundCity((int) (placement() % map.getWidth()),
+                                                (int) (placement() % map.getHeight()),
+                                                player);
+                if (city >= 0) {
+                    cities.push_back(city);
+                    break;
+                }
+            }
+        }
+    }
+    double foundSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uint64_t foundVisited = territory->getTilesVisited();
+
+    start = std::chrono::steady_clock::now();
+    territory->rebuild();
+    double rebuildSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("Territory: %d cities founded in %.3f ms (%llu tiles visited), full rebuild %.3f ms (%llu tiles)\n",
+           (int) cities.size(),
+           foundSeconds * 1000,
+           (unsigned long long) foundVisited,
+           rebuildSeconds * 1000,
+           (unsigned long long) (territory->getTilesVisited() - foundVisited));
+
+    if (territoryEdits > 0 && !verifyTerritory(&simulation, cities, players, territoryEdits, seed)) {
+        return 1;
+    }
+
+    // Autosaves write a snapshot on a background thread while turns go on;
+    // one still running when the next is due is skipped, never waited for
+    std::thread autosaveThread;
+    std::atomic<bool> autosaveBusy(false);
+    std::atomic<int> autosavesFailed(0);
+    int autosaves = 0;
+    int autosavesSkipped = 0;
+
+    AllocationTracker &allocations = AllocationTracker::instance();
+    uint64_t worstTurnAllocations = 0;
+    int allocatingTurns = 0;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < turns; i++) {
+        allocations.beginFrame();
+        simulation.runTurn();
+
+        // Taking the snapshot is part of the turn's cost, so it counts
+        // towards the turn's allocations; writing it out does not
+        if (autosavePath != nullptr && autosaveEvery > 0 && (i + 1) % autosaveEvery == 0) {
+            if (autosaveBusy.load()) {
+                autosavesSkipped++;
+            } else {
+                if (autosaveThread.joinable()) {
+                    autosaveThread.join();
+                }
+
+                std::shared_ptr<const WorldSnapshot> snapshot = simulation.snapshot();
+                autosaveBusy = true;
+                autosaveThread = std::thread([snapshot, autosavePath, &autosaveBusy, &autosavesFailed]() {
+                    AllocationScope scope(ALLOC_SAVE);
+                    if (!snapshot->map.save(autosavePath)) {
+                        autosavesFailed++;
+                    }
+                    autosaveBusy = false;
+                });
+                autosaves++;
+            }
+        }
+
+        allocations.endFrame();
+
+        uint64_t turnAllocations = allocations.getLastFrame().allocations;
+        if (i >= ALLOC_WARMUP_TURNS) {
+            worstTurnAllocations = std::max(worstTurnAllocations, turnAllocations);
+            allocatingTurns += turnAllocations > 0 ? 1 : 0;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (autosaveThread.joinable()) {
+        autosaveThread.join();
+    }
+
+    printf("%d turns in %.3f s: %.1f turns/sec, %.1f ns per unit-turn\n",
+           turns,
+           seconds,
+           seconds > 0 ? turns / seconds : 0.0,
+           units > 0 && turns > 0 ? seconds * 1e9 / ((double) units * turns) : 0.0);
+
+    printf("Flow fields: %llu hits, %llu misses\n",
+           (unsigned long long) simulation.getFlowFields()->getHits(),
+           (unsigned long long) simulation.getFlowFields()->getMisses());
+
+    if (autosavePath != nullptr) {
+        printf("Autosaves: %d written, %d failed, %d skipped while busy\n",
+               autosaves - autosavesFailed.load(),
+               autosavesFailed.load(),
+               autosavesSkipped);
+    }
+
+    if (AllocationTracker::isEnabled()) {
+        printf("Allocations: worst turn %llu, %d of %d turns allocating after warm-up\n",
+               (unsigned long long) worstTurnAllocations,
+               allocatingTurns,
+               std::max(0, turns - ALLOC_WARMUP_TURNS));
+        allocations.printSubsystems();
+    } else if (allocationBudget >= 0) {
+        printf("--alloc-budget needs a build with CIV_TRACK_ALLOCATIONS\n");
+        return 1;
+    }
+
+    if (savePath != nullptr && !map.save(savePath)) {
+        return 1;
+    }
+
+    if (allocationBudget >= 0 && worstTurnAllocations > (uint64_t) allocationBudget) {
+        printf("Allocation budget exceeded: %llu > %lld per turn\n",
+               (unsigned long long) worstTurnAllocations,
+               allocationBudget);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,194 @@
+#include <SDL.h>
+#include <SDL_image.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../engine/AssetPack.h"
+#include "../engine/Lz4.h"
+
+// Bundles fonts and images into a single pack file that the game maps at
+// startup. Images are decoded here, once, so the runtime never touches zlib.
+//
+// Usage: civ_pack [--lz4] <output.pack> <asset>...
+
+struct PackedAsset {
+    AssetPackEntry entry;
+    std::vector<uint8_t> payload;
+};
+
+static bool endsWith(const std::string &s, const std::string &suffix) {
+    return s.size() >= suffix.size() &&
+           s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+static bool readFile(const std::string &path, std::vector<uint8_t> *out) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        printf("Unable to open %s!\n", path.c_str());
+        return false;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    out->resize((size_t) size);
+    bool success = fread(out->data(), 1, out->size(), file) == out->size();
+    fclose(file);
+
+    return success;
+}
+
+static bool decodeImage(const std::string &path, PackedAsset *asset) {
+    SDL_Surface *loadedSurface = IMG_Load(path.c_str());
+    if (loadedSurface == nullptr) {
+        printf("Unable to load image %s! SDL_image Error: %s\n", path.c_str(), IMG_GetError());
+        return false;
+    }
+
+    // Match the cyan color key Texture::loadFromFile applies to loose images
+    SDL_SetColorKey(loadedSurface,
+                    SDL_TRUE,
+                    SDL_MapRGB(loadedSurface->format, 0, 0xFF, 0xFF));
+
+    SDL_Surface *rgba = SDL_ConvertSurfaceFormat(loadedSurface, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(loadedSurface);
+    if (rgba == nullptr) {
+        printf("Unable to convert %s to RGBA! SDL Error: %s\n", path.c_str(), SDL_GetError());
+        return false;
+    }
+
+    size_t rowBytes = (size_t) rgba->w * 4;
+    asset->entry.width = (uint32_t) rgba->w;
+    asset->entry.height = (uint32_t) rgba->h;
+    asset->payload.resize(rowBytes * rgba->h);
+
+    SDL_LockSurface(rgba);
+    for (int row = 0; row < rgba->h; row++) {
+        memcpy(asset->payload.data() + row * rowBytes,
+               (const uint8_t *) rgba->pixels + row * rgba->pitch,
+               rowBytes);
+    }
+    SDL_UnlockSurface(rgba);
+    SDL_FreeSurface(rgba);
+
+    return true;
+}
+
+static void compress(PackedAsset *asset) {
+    std::vector<uint8_t> compressed(lz4CompressBound((int) asset->payload.size()));
+    int size = lz4CompressBlock(asset->payload.data(),
+                                (int) asset->payload.size(),
+                                compressed.data(),
+                                (int) compressed.size());
+
+    // Keep the raw bytes when compression does not pay for the extra decode
+    if (size > 0 && (size_t) size < asset->payload.size() - asset->payload.size() / 8) {
+        compressed.resize((size_t) size);
+        asset->payload.swap(compressed);
+        asset->entry.flags |= ASSET_FLAG_LZ4;
+    }
+}
+
+int main(int argc, char *args[]) {
+    bool useLz4 = false;
+    int first = 1;
+
+    if (argc > 1 && strcmp(args[1], "--lz4") == 0) {
+        useLz4 = true;
+        first++;
+    }
+
+    if (argc - first < 2) {
+        printf("Usage: civ_pack [--lz4] <output.pack> <asset>...\n");
+        return 1;
+    }
+
+    std::string outputPath = args[first];
+    std::vector<PackedAsset> assets;
+
+    if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
+        printf("SDL_image Error: %s\n", IMG_GetError());
+        return 1;
+    }
+
+    for (int i = first + 1; i < argc; i++) {
+        std::string path = args[i];
+        if (path.size() >= (size_t) ASSET_NAME_LENGTH) {
+            printf("Asset name too long: %s\n", path.c_str());
+            return 1;
+        }
+
+        PackedAsset asset;
+        memset(&asset.entry, 0, sizeof(asset.entry));
+        strncpy(asset.entry.name, path.c_str(), ASSET_NAME_LENGTH - 1);
+
+        bool loaded;
+        if (endsWith(path, ".ttf") || endsWith(path, ".TTF")) {
+            asset.entry.type = ASSET_TYPE_FONT;
+            loaded = readFile(path, &asset.payload);
+        } else {
+            asset.entry.type = ASSET_TYPE_IMAGE;
+            loaded = decodeImage(path, &asset);
+            if (loaded && useLz4) {
+                asset.entry.rawSize = asset.payload.size();
+                compress(&asset);
+            }
+        }
+
+        if (!loaded) {
+            return 1;
+        }
+
+        if (asset.entry.rawSize == 0) {
+            asset.entry.rawSize = asset.payload.size();
+        }
+        asset.entry.size = asset.payload.size();
+        assets.push_back(asset);
+    }
+
+    IMG_Quit();
+
+    AssetPackHeader header;
+    memcpy(header.magic, ASSET_PACK_MAGIC, sizeof(header.magic));
+    header.version = ASSET_PACK_VERSION;
+    header.entryCount = (uint32_t) assets.size();
+
+    uint64_t offset = sizeof(AssetPackHeader) + assets.size() * sizeof(AssetPackEntry);
+    for (auto &asset : assets) {
+        offset = (offset + ASSET_PACK_ALIGNMENT - 1) & ~(ASSET_PACK_ALIGNMENT - 1);
+        asset.entry.offset = offset;
+        offset += asset.entry.size;
+    }
+
+    FILE *file = fopen(outputPath.c_str(), "wb");
+    if (file == nullptr) {
+        printf("Unable to open %s for writing!\n", outputPath.c_str());
+        return 1;
+    }
+
+    fwrite(&header, sizeof(header), 1, file);
+    for (auto &asset : assets) {
+        fwrite(&asset.entry, sizeof(asset.entry), 1, file);
+    }
+
+    static const uint8_t padding[ASSET_PACK_ALIGNMENT] = {0};
+    for (auto &asset : assets) {
+        long position = ftell(file);
+        fwrite(padding, 1, (size_t) (asset.entry.offset - position), file);
+        fwrite(asset.payload.data(), 1, asset.payload.size(), file);
+
+        printf("%-72s %8llu -> %8llu bytes%s\n",
+               asset.entry.name,
+               (unsigned long long) asset.entry.rawSize,
+               (unsigned long long) asset.entry.size,
+               (asset.entry.flags & ASSET_FLAG_LZ4) ? " (lz4)" : "");
+    }
+
+    bool success = ferror(file) == 0;
+    fclose(file);
+
+    return success ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+#ifndef CIV_COWGRID_H
+#define CIV_COWGRID_H
+
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+const int COW_CHUNK_SHIFT = 4;
+const int COW_CHUNK_SIZE = 1 << COW_CHUNK_SHIFT;
+
+// 2D grid stored as COW_CHUNK_SIZE square chunks that copies of the grid
+// share. Copying costs one reference per chunk; the first write to a
+// shared chunk clones just that chunk, so a copy is an immutable snapshot
+// of the grid at that moment.
+//
+// Copies may be read and destroyed on any thread. Writes and copies of a
+// given grid must stay on one thread: a chunk seen with a single reference
+// can then only be held by the writer.
+template<typename T>
+class CowGrid {
+    static_assert(std::is_trivially_copyable<T>::value, "CowGrid cells are copied with memcpy");
+
+public:
+    CowGrid() :
+            width(0),
+            height(0),
+            chunkColumns(0) {
+
+    }
+
+    CowGrid(int width, int height, T value) :
+            width(0),
+            height(0),
+            chunkColumns(0) {
+        assign(width, height, value);
+    }
+
+    CowGrid(const CowGrid &other) :
+            width(other.width),
+            height(other.height),
+            chunkColumns(other.chunkColumns),
+            chunks(other.chunks) {
+        for (Chunk *chunk : chunks) {
+            chunk->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    CowGrid(CowGrid &&other) noexcept :
+            width(other.width),
+            height(other.height),
+            chunkColumns(other.chunkColumns),
+            chunks(std::move(other.chunks)) {
+        other.chunks.clear();
+    }
+
+    CowGrid &operator=(CowGrid other) {
+        swap(other);
+        return *this;
+    }
+
+    ~CowGrid() {
+        releaseAll();
+    }
+
+    void swap(CowGrid &other) {
+        std::swap(width, other.width);
+        std::swap(height, other.height);
+        std::swap(chunkColumns, other.chunkColumns);
+        chunks.swap(other.chunks);
+    }
+
+    // Replaces every chunk with a fresh one rather than cloning shared ones
+    void assign(int newWidth, int newHeight, T value) {
+        releaseAll();
+
+        width = newWidth;
+        height = newHeight;
+        chunkColumns = (width + COW_CHUNK_SIZE - 1) >> COW_CHUNK_SHIFT;
+        int chunkRows = (height + COW_CHUNK_SIZE - 1) >> COW_CHUNK_SHIFT;
+
+        chunks.resize((size_t) chunkColumns * chunkRows);
+        for (Chunk *&chunk : chunks) {
+            chunk = new Chunk();
+            for (T &cell : chunk->cells) {
+                cell = value;
+            }
+        }
+    }
+
+    int getWidth() const {
+        return width;
+    }
+
+    int getHeight() const {
+        return height;
+    }
+
+    const T &get(int x, int y) const {
+        return chunks[chunkIndex(x, y)]->cells[cellIndex(x, y)];
+    }
+
+    void set(int x, int y, T value) {
+        writableChunk(chunkIndex(x, y))->cells[cellIndex(x, y)] = value;
+    }
+
+    // Chunks also referenced by another copy, i.e. not yet written since it was taken
+    size_t getSharedChunkCount() const {
+        size_t shared = 0;
+        for (const Chunk *chunk : chunks) {
+            if (chunk->refs.load(std::memory_order_relaxed) > 1) {
+                shared++;
+            }
+        }
+        return shared;
+    }
+
+    size_t getChunkCount() const {
+        return chunks.size();
+    }
+
+private:
+    struct Chunk {
+        Chunk() :
+                refs(1) {
+
+        }
+
+        std::atomic<int> refs;
+        T cells[COW_CHUNK_SIZE * COW_CHUNK_SIZE];
+    };
+
+    size_t chunkIndex(int x, int y) const {
+        return (size_t) (y >> COW_CHUNK_SHIFT) * chunkColumns + (x >> COW_CHUNK_SHIFT);
+    }
+
+    static int cellIndex(int x, int y) {
+        return (y & (COW_CHUNK_SIZE - 1)) << COW_CHUNK_SHIFT | (x & (COW_CHUNK_SIZE - 1));
+    }
+
+    Chunk *writableChunk(size_t index) {
+        Chunk *chunk = chunks[index];
+
+        // Acquire pairs with the release in other copies' destructors, so
+        // their last reads finish before we write in place
+        if (chunk->refs.load(std::memory_order_acquire) != 1) {
+            Chunk *copy = new Chunk();
+            memcpy(copy->cells, chunk->cells, sizeof(copy->cells));
+            release(chunk);
+            chunks[index] = copy;
+            chunk = copy;
+        }
+
+        return chunk;
+    }
+
+    static void release(Chunk *chunk) {
+        if (chunk->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete chunk;
+        }
+    }
+
+    void releaseAll() {
+        for (Chunk *chunk : chunks) {
+            release(chunk);
+        }
+        chunks.clear();
+    }
+
+    int width;
+    int height;
+    int chunkColumns;
+    std::vector<Chunk *> chunks;
+};
+
+#endif
@@ -0,0 +1,194 @@
+#include <functional>
+#include <queue>
+#include "FlowField.h"
+#include "../engine/AllocationTracker.h"
+
+// Orthogonal and diagonal step weights, scaled so diagonals cost ~sqrt(2)
+static const uint32_t STRAIGHT_WEIGHT = 10;
+static const uint32_t DIAGONAL_WEIGHT = 14;
+static const int NEIGHBOURS[8][2] = {
+        {-1, -1}, {0, -1}, {1, -1},
+        {-1, 0}, {1, 0},
+        {-1, 1}, {0, 1}, {1, 1}
+};
+
+FlowField::FlowField(const GameMap *map, int goalX, int goalY) :
+        map(map),
+        width(map->getWidth()),
+        height(map->getHeight()),
+        goalX(goalX),
+        goalY(goalY),
+        regionColumns((width + FLOW_REGION_SIZE - 1) / FLOW_REGION_SIZE) {
+
+}
+
+void FlowField::compute() {
+    int regionRows = (height + FLOW_REGION_SIZE - 1) / FLOW_REGION_SIZE;
+
+    costs.assign((size_t) width * height, FLOW_UNREACHABLE);
+    directions.assign((size_t) width * height, -1);
+    regions.assign((size_t) regionColumns * regionRows, false);
+
+    if (!map->inBounds(goalX, goalY)) {
+        return;
+    }
+
+    // Even an unreachable goal depends on its own tile, so making it
+    // passable must invalidate the field
+    regions[(goalY / FLOW_REGION_SIZE) * regionColumns + goalX / FLOW_REGION_SIZE] = true;
+
+    if (!map->isPassable(goalX, goalY)) {
+        return;
+    }
+
+    typedef std::pair<uint32_t, int> QueueItem;
+    std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> open;
+
+    int goal = goalY * width + goalX;
+    costs[goal] = 0;
+    open.push(QueueItem(0, goal));
+
+    while (!open.empty()) {
+        QueueItem item = open.top();
+        open.pop();
+
+        int tile = item.second;
+        if (item.first != costs[tile]) {
+            continue;
+        }
+
+        int x = tile % width;
+        int y = tile / width;
+        regions[(y / FLOW_REGION_SIZE) * regionColumns + x / FLOW_REGION_SIZE] = true;
+
+        // Units step from the neighbour onto this tile, paying its cost
+        uint32_t enterCost = (uint32_t) map->getMoveCost(x, y);
+
+        for (int d = 0; d < 8; d++) {
+            int nx = x + NEIGHBOURS[d][0];
+            int ny = y + NEIGHBOURS[d][1];
+            if (!map->inBounds(nx, ny) || !map->isPassable(nx, ny)) {
+                continue;
+            }
+
+            bool diagonal = NEIGHBOURS[d][0] != 0 && NEIGHBOURS[d][1] != 0;
+            if (diagonal && (!map->isPassable(nx, y) || !map->isPassable(x, ny))) {
+                continue;
+            }
+
+            uint32_t cost = item.first + enterCost * (diagonal ? DIAGONAL_WEIGHT : STRAIGHT_WEIGHT);
+            int neighbour = ny * width + nx;
+            if (cost < costs[neighbour]) {
+                costs[neighbour] = cost;
+                directions[neighbour] = (int8_t) (7 - d);
+                open.push(QueueItem(cost, neighbour));
+            }
+        }
+    }
+}
+
+int FlowField::getGoalX() const {
+    return goalX;
+}
+
+int FlowField::getGoalY() const {
+    return goalY;
+}
+
+uint32_t FlowField::getCost(int x, int y) const {
+    return costs[y * width + x];
+}
+
+bool FlowField::getStep(int x, int y, int *dx, int *dy) const {
+    int direction = directions[y * width + x];
+    if (direction < 0) {
+        return false;
+    }
+
+    *dx = NEIGHBOURS[direction][0];
+    *dy = NEIGHBOURS[direction][1];
+    return true;
+}
+
+bool FlowField::dependsOnRegion(int regionX, int regionY) const {
+    int regionRows = (int) regions.size() / regionColumns;
+
+    for (int ry = regionY - 1; ry <= regionY + 1; ry++) {
+        for (int rx = regionX - 1; rx <= regionX + 1; rx++) {
+            if (rx >= 0 && rx < regionColumns && ry >= 0 && ry < regionRows &&
+                regions[ry * regionColumns + rx]) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+FlowFieldCache::FlowFieldCache(const GameMap *map, size_t capacity) :
+        map(map),
+        capacity(capacity),
+        hits(0),
+        misses(0) {
+
+}
+
+std::shared_ptr<const FlowField> FlowFieldCache::get(int goalX, int goalY) {
+    int key = goalY * map->getWidth() + goalX;
+
+    auto it = index.find(key);
+    if (it != index.end()) {
+        fields.splice(fields.begin(), fields, it->second);
+        hits++;
+        return fields.front();
+    }
+
+    misses++;
+    AllocationScope scope(ALLOC_PATHFINDING);
+
+    if (fields.size() >= capacity) {
+        const FlowField &oldest = *fields.back();
+        index.erase(oldest.getGoalY() * map->getWidth() + oldest.getGoalX());
+        fields.pop_back();
+    }
+
+    fields.push_front(std::make_shared<FlowField>(map, goalX, goalY));
+    fields.front()->compute();
+    index[key] = fields.begin();
+
+    return fields.front();
+}
+
+void FlowFieldCache::reserve(size_t fields) {
+    if (fields > capacity) {
+        capacity = fields;
+    }
+}
+
+void FlowFieldCache::invalidateTile(int x, int y) {
+    invalidateRegion(x / FLOW_REGION_SIZE, y / FLOW_REGION_SIZE);
+}
+
+void FlowFieldCache::invalidateRegion(int regionX, int regionY) {
+    for (auto it = fields.begin(); it != fields.end();) {
+        if ((*it)->dependsOnRegion(regionX, regionY)) {
+            index.erase((*it)->getGoalY() * map->getWidth() + (*it)->getGoalX());
+            it = fields.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void FlowFieldCache::clear() {
+    fields.clear();
+    index.clear();
+}
+
+uint64_t FlowFieldCache::getHits() const {
+    return hits;
+}
+
+uint64_t FlowFieldCache::getMisses() const {
+    return misses;
+}
@@ -0,0 +1,84 @@
+#ifndef CIV_FLOWFIELD_H
+#define CIV_FLOWFIELD_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "GameMap.h"
+
+const uint32_t FLOW_UNREACHABLE = UINT32_MAX;
+const int FLOW_REGION_SIZE = 16;
+
+// Shortest-path field towards a single goal tile. compute() runs one
+// Dijkstra pass outward from the goal over the terrain move costs, giving
+// every tile its integrated cost to the goal and the neighbour to step to.
+// Any number of units can then follow the field in O(1) per step.
+class FlowField {
+public:
+    FlowField(const GameMap *map, int goalX, int goalY);
+
+    void compute();
+
+    int getGoalX() const;
+
+    int getGoalY() const;
+
+    uint32_t getCost(int x, int y) const;
+
+    // Writes the step towards the goal; false at the goal or if unreachable
+    bool getStep(int x, int y, int *dx, int *dy) const;
+
+    // True if any tile in or next to the region was reached, i.e. a terrain
+    // change inside the region could alter this field
+    bool dependsOnRegion(int regionX, int regionY) const;
+
+private:
+    const GameMap *map;
+    int width;
+    int height;
+    int goalX;
+    int goalY;
+    int regionColumns;
+    std::vector<uint32_t> costs;
+    std::vector<int8_t> directions;
+    std::vector<bool> regions;
+};
+
+// LRU cache of flow fields keyed by goal tile. Terrain changes must be
+// reported through invalidateTile(), which drops only the fields whose
+// reached area touches the changed region. Fields are shared, so one held
+// by a caller stays valid after the cache evicts or drops it.
+class FlowFieldCache {
+public:
+    FlowFieldCache(const GameMap *map, size_t capacity = 32);
+
+    std::shared_ptr<const FlowField> get(int goalX, int goalY);
+
+    // Raises the capacity to at least this many fields
+    void reserve(size_t fields);
+
+    void invalidateTile(int x, int y);
+
+    void invalidateRegion(int regionX, int regionY);
+
+    void clear();
+
+    uint64_t getHits() const;
+
+    uint64_t getMisses() const;
+
+private:
+    typedef std::list<std::shared_ptr<FlowField>> FieldList;
+
+    const GameMap *map;
+    size_t capacity;
+    FieldList fields;
+    std::unordered_map<int, FieldList::iterator> index;
+    uint64_t hits;
+    uint64_t misses;
+};
+
+#endif
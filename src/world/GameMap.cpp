@@ -0,0 +1,97 @@
+#include <cstdio>
+#include <random>
+#include "GameMap.h"
+#include "../engine/constants.h"
+
+GameMap::GameMap(int width, int height) :
+        width(width),
+        height(height),
+        terrain(width, height, GRASS1_TILE) {
+
+}
+
+int GameMap::getWidth() const {
+    return width;
+}
+
+int GameMap::getHeight() const {
+    return height;
+}
+
+void GameMap::setTerrain(int x, int y, int t) {
+    terrain.set(x, y, (uint8_t) t);
+}
+
+TileYields GameMap::getYields(int x, int y) const {
+    const TerrainInfo &info = terrainInfo(getTerrain(x, y));
+    return TileYields{info.food, info.production, info.gold, info.science};
+}
+
+void GameMap::generate(unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> clip(0, NUM_TERRAIN_CLIPS - 1);
+
+    // Fresh chunks, so snapshots still holding the old terrain are not cloned
+    terrain.assign(width, height, GRASS1_TILE);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            terrain.set(x, y, (uint8_t) clip(rng));
+        }
+    }
+}
+
+bool GameMap::load(std::string path) {
+    FILE *file = fopen(path.c_str(), "r");
+    if (file == nullptr) {
+        printf("Unable to open map %s!\n", path.c_str());
+        return false;
+    }
+
+    int w;
+    int h;
+    if (fscanf(file, "%d %d", &w, &h) != 2 || w <= 0 || h <= 0) {
+        printf("Map %s has no valid size header!\n", path.c_str());
+        fclose(file);
+        return false;
+    }
+
+    CowGrid<uint8_t> loaded(w, h, GRASS1_TILE);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            int value;
+            if (fscanf(file, "%d", &value) != 1 || value < 0 || value >= NUM_TERRAIN_CLIPS) {
+                printf("Map %s has missing or invalid terrain!\n", path.c_str());
+                fclose(file);
+                return false;
+            }
+            loaded.set(x, y, (uint8_t) value);
+        }
+    }
+    fclose(file);
+
+    width = w;
+    height = h;
+    terrain.swap(loaded);
+
+    return true;
+}
+
+bool GameMap::save(std::string path) const {
+    FILE *file = fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        printf("Unable to open map %s for writing!\n", path.c_str());
+        return false;
+    }
+
+    fprintf(file, "%d %d\n", width, height);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            fprintf(file, x + 1 < width ? "%d " : "%d\n", getTerrain(x, y));
+        }
+    }
+
+    bool success = ferror(file) == 0;
+    fclose(file);
+
+    return success;
+}
@@ -0,0 +1,75 @@
+#ifndef CIV_GAMEMAP_H
+#define CIV_GAMEMAP_H
+
+#include <cstdint>
+#include <string>
+
+#include "CowGrid.h"
+#include "TerrainRegistry.h"
+
+struct TileYields {
+    int food;
+    int production;
+    int gold;
+    int science;
+};
+
+// The world's terrain grid, independent of any renderer. Each tile stores
+// the terrain id from constants.h (GRASS1_TILE .. HILLS4_TILE); the game's
+// Tile objects are built from it for drawing, and civ_sim uses it directly.
+//
+// Terrain is held in a CowGrid, so copying a map is a cheap snapshot that
+// later edits to the original do not disturb.
+class GameMap {
+public:
+    GameMap(int width, int height);
+
+    int getWidth() const;
+
+    int getHeight() const;
+
+    bool inBounds(int x, int y) const;
+
+    int getTerrain(int x, int y) const;
+
+    void setTerrain(int x, int y, int terrain);
+
+    bool isPassable(int x, int y) const;
+
+    // Movement points spent entering the tile, or IMPASSABLE
+    int getMoveCost(int x, int y) const;
+
+    TileYields getYields(int x, int y) const;
+
+    void generate(unsigned seed);
+
+    bool load(std::string path);
+
+    bool save(std::string path) const;
+
+private:
+    int width;
+    int height;
+    CowGrid<uint8_t> terrain;
+};
+
+// The per-tile queries below run in every pathfinding inner loop, so they
+// are inline
+
+inline bool GameMap::inBounds(int x, int y) const {
+    return x >= 0 && x < width && y >= 0 && y < height;
+}
+
+inline int GameMap::getTerrain(int x, int y) const {
+    return terrain.get(x, y);
+}
+
+inline bool GameMap::isPassable(int x, int y) const {
+    return getMoveCost(x, y) != IMPASSABLE;
+}
+
+inline int GameMap::getMoveCost(int x, int y) const {
+    return terrainInfo(getTerrain(x, y)).moveCost;
+}
+
+#endif
@@ -0,0 +1,290 @@
+#include <algorithm>
+#include "InfluenceMap.h"
+#include "../engine/AllocationTracker.h"
+
+static const uint32_t STRAIGHT_WEIGHT = 10;
+static const uint32_t DIAGONAL_WEIGHT = 14;
+// Water can be claimed from the coast but does not carry influence further
+static const uint32_t IMPASSABLE_ENTER_COST = 1;
+static const int NEIGHBOURS[8][2] = {
+        {-1, -1}, {0, -1}, {1, -1},
+        {-1, 0}, {1, 0},
+        {-1, 1}, {0, 1}, {1, 1}
+};
+
+InfluenceMap::InfluenceMap(const GameMap *map, uint16_t range) :
+        map(map),
+        width(0),
+        height(0),
+        range(range),
+        version(0),
+        tilesVisited(0) {
+    rebuild();
+}
+
+int InfluenceMap::addSource(int x, int y, int owner) {
+    AllocationScope scope(ALLOC_TERRITORY);
+
+    // Owners are stored as bytes, with the top value meaning unowned
+    if (owner < 0 || owner >= INFLUENCE_NO_OWNER ||
+        !map->inBounds(x, y) || !map->isPassable(x, y)) {
+        return -1;
+    }
+
+    uint16_t id;
+    if (!freeSources.empty()) {
+        id = freeSources.back();
+        freeSources.pop_back();
+    } else if (sourceList.size() < INFLUENCE_NO_SOURCE) {
+        id = (uint16_t) sourceList.size();
+        sourceList.push_back(Source());
+    } else {
+        return -1;
+    }
+
+    sourceList[id] = Source{x, y, owner, true};
+
+    // A new source can only take tiles away, so relaxing outward from it
+    // touches exactly the tiles it wins
+    seed(y * width + x, id);
+    propagate();
+    version++;
+
+    return id;
+}
+
+void InfluenceMap::removeSource(int source) {
+    AllocationScope scope(ALLOC_TERRITORY);
+
+    if (source < 0 || (size_t) source >= sourceList.size() || !sourceList[source].alive) {
+        return;
+    }
+
+    Source &removed = sourceList[source];
+    removed.alive = false;
+    freeSources.push_back((uint16_t) source);
+
+    // Every tile it held lies within range of it; the rest keep their labels
+    clearBox(removed.x, removed.y, range / STRAIGHT_WEIGHT, (uint16_t) source);
+    repair();
+    version++;
+}
+
+void InfluenceMap::setSourceOwner(int source, int owner) {
+    if (source < 0 || (size_t) source >= sourceList.size() || !sourceList[source].alive ||
+        owner < 0 || owner >= INFLUENCE_NO_OWNER) {
+        return;
+    }
+
+    Source &captured = sourceList[source];
+    captured.owner = owner;
+
+    int radius = range / STRAIGHT_WEIGHT;
+    for (int y = std::max(0, captured.y - radius); y <= std::min(height - 1, captured.y + radius); y++) {
+        for (int x = std::max(0, captured.x - radius); x <= std::min(width - 1, captured.x + radius); x++) {
+            int tile = y * width + x;
+            if (sources[tile] == source) {
+                owners[tile] = (uint8_t) owner;
+            }
+        }
+    }
+
+    version++;
+}
+
+void InfluenceMap::clearSources() {
+    sourceList.clear();
+    freeSources.clear();
+    rebuild();
+}
+
+void InfluenceMap::invalidateTile(int x, int y) {
+    AllocationScope scope(ALLOC_TERRITORY);
+
+    if (!map->inBounds(x, y)) {
+        return;
+    }
+
+    // Any path through the tile ends within range of it, so only labels in
+    // this box can change
+    clearBox(x, y, range / STRAIGHT_WEIGHT, INFLUENCE_NO_SOURCE);
+    repair();
+    version++;
+}
+
+void InfluenceMap::rebuild() {
+    AllocationScope scope(ALLOC_TERRITORY);
+
+    width = map->getWidth();
+    height = map->getHeight();
+
+    size_t tiles = (size_t) width * height;
+    owners.assign(tiles, INFLUENCE_NO_OWNER);
+    distances.assign(tiles, INFLUENCE_UNREACHED);
+    sources.assign(tiles, INFLUENCE_NO_SOURCE);
+
+    for (size_t id = 0; id < sourceList.size(); id++) {
+        const Source &source = sourceList[id];
+        if (source.alive && map->inBounds(source.x, source.y)) {
+            seed(source.y * width + source.x, (uint16_t) id);
+        }
+    }
+
+    propagate();
+    version++;
+}
+
+int InfluenceMap::getWidth() const {
+    return width;
+}
+
+int InfluenceMap::getHeight() const {
+    return height;
+}
+
+uint8_t InfluenceMap::getOwner(int x, int y) const {
+    return owners[y * width + x];
+}
+
+uint16_t InfluenceMap::getDistance(int x, int y) const {
+    return distances[y * width + x];
+}
+
+uint16_t InfluenceMap::getSource(int x, int y) const {
+    return sources[y * width + x];
+}
+
+bool InfluenceMap::isBorder(int x, int y) const {
+    uint8_t owner = owners[y * width + x];
+    if (owner == INFLUENCE_NO_OWNER) {
+        return false;
+    }
+
+    return (x > 0 && owners[y * width + x - 1] != owner) ||
+           (x < width - 1 && owners[y * width + x + 1] != owner) ||
+           (y > 0 && owners[(y - 1) * width + x] != owner) ||
+           (y < height - 1 && owners[(y + 1) * width + x] != owner);
+}
+
+const uint8_t *InfluenceMap::getOwners() const {
+    return owners.data();
+}
+
+const uint16_t *InfluenceMap::getDistances() const {
+    return distances.data();
+}
+
+uint32_t InfluenceMap::getVersion() const {
+    return version;
+}
+
+uint64_t InfluenceMap::getTilesVisited() const {
+    return tilesVisited;
+}
+
+uint32_t InfluenceMap::labelOf(int tile) const {
+    return (uint32_t) distances[tile] << 16 | sources[tile];
+}
+
+void InfluenceMap::seed(int tile, uint16_t source) {
+    if ((uint32_t) source < labelOf(tile)) {
+        distances[tile] = 0;
+        sources[tile] = source;
+        owners[tile] = (uint8_t) sourceList[source].owner;
+        open.push((uint64_t) source << 32 | (uint32_t) tile);
+    }
+}
+
+void InfluenceMap::clearBox(int x, int y, int radius, uint16_t source) {
+    cleared.clear();
+
+    for (int row = std::max(0, y - radius); row <= std::min(height - 1, y + radius); row++) {
+        for (int col = std::max(0, x - radius); col <= std::min(width - 1, x + radius); col++) {
+            int tile = row * width + col;
+            if (sources[tile] != INFLUENCE_NO_SOURCE &&
+                (source == INFLUENCE_NO_SOURCE || sources[tile] == source)) {
+                owners[tile] = INFLUENCE_NO_OWNER;
+                distances[tile] = INFLUENCE_UNREACHED;
+                sources[tile] = INFLUENCE_NO_SOURCE;
+                cleared.push_back(tile);
+            }
+        }
+    }
+}
+
+void InfluenceMap::repair() {
+    // Labels outside the cleared tiles are still optimal, so the cleared
+    // area is refilled from its labelled edge plus any sources inside it
+    for (int tile : cleared) {
+        int x = tile % width;
+        int y = tile / width;
+
+        for (auto neighbour : NEIGHBOURS) {
+            int nx = x + neighbour[0];
+            int ny = y + neighbour[1];
+            if (map->inBounds(nx, ny) &&
+                sources[ny * width + nx] != INFLUENCE_NO_SOURCE &&
+                map->isPassable(nx, ny)) {
+                int edge = ny * width + nx;
+                open.push((uint64_t) labelOf(edge) << 32 | (uint32_t) edge);
+            }
+        }
+    }
+
+    for (size_t id = 0; id < sourceList.size(); id++) {
+        const Source &source = sourceList[id];
+        if (source.alive) {
+            seed(source.y * width + source.x, (uint16_t) id);
+        }
+    }
+
+    propagate();
+}
+
+void InfluenceMap::propagate() {
+    while (!open.empty()) {
+        uint64_t item = open.top();
+        open.pop();
+
+        int tile = (int) (item & 0xFFFFFFFF);
+        if ((uint32_t) (item >> 32) != labelOf(tile)) {
+            continue;
+        }
+
+        tilesVisited++;
+
+        int x = tile % width;
+        int y = tile / width;
+        if (!map->isPassable(x, y)) {
+            continue;
+        }
+
+        uint16_t source = sources[tile];
+        uint8_t owner = owners[tile];
+
+        for (int d = 0; d < 8; d++) {
+            int nx = x + NEIGHBOURS[d][0];
+            int ny = y + NEIGHBOURS[d][1];
+            if (!map->inBounds(nx, ny)) {
+                continue;
+            }
+
+            int moveCost = map->getMoveCost(nx, ny);
+            uint32_t enterCost = moveCost == IMPASSABLE ? IMPASSABLE_ENTER_COST : (uint32_t) moveCost;
+            bool diagonal = NEIGHBOURS[d][0] != 0 && NEIGHBOURS[d][1] != 0;
+            uint32_t distance = distances[tile] + enterCost * (diagonal ? DIAGONAL_WEIGHT : STRAIGHT_WEIGHT);
+            if (distance > range) {
+                continue;
+            }
+
+            int neighbour = ny * width + nx;
+            uint32_t label = distance << 16 | source;
+            if (label < labelOf(neighbour)) {
+                distances[neighbour] = (uint16_t) distance;
+                sources[neighbour] = source;
+                owners[neighbour] = owner;
+                open.push((uint64_t) label << 32 | (uint32_t) neighbour);
+            }
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef CIV_INFLUENCEMAP_H
+#define CIV_INFLUENCEMAP_H
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "GameMap.h"
+
+const uint8_t INFLUENCE_NO_OWNER = 0xFF;
+const uint16_t INFLUENCE_NO_SOURCE = 0xFFFF;
+const uint16_t INFLUENCE_UNREACHED = 0xFFFF;
+// Three grassland tiles, using the same 10/14 step weights as FlowField
+const uint16_t INFLUENCE_DEFAULT_RANGE = 30;
+
+// Territory from multi-source Dijkstra over terrain costs. Every source
+// (a city) claims the tiles it reaches within the range; a tile goes to
+// the nearest source, ties to the lower source id, so the result never
+// depends on the order of updates.
+//
+// Adding, removing or re-owning a source and changing terrain repair only
+// the tiles that can be affected instead of recomputing the map. Owners
+// and distances are kept in packed per-tile arrays the renderer reads
+// directly; getVersion() changes whenever they do.
+class InfluenceMap {
+public:
+    InfluenceMap(const GameMap *map, uint16_t range = INFLUENCE_DEFAULT_RANGE);
+
+    // Returns the source id, or -1 if the tile is off the map or impassable
+    // or the owner does not fit below INFLUENCE_NO_OWNER
+    int addSource(int x, int y, int owner);
+
+    void removeSource(int source);
+
+    // Capture: hands every tile the source holds to the new owner. Owners
+    // addSource() would reject are ignored.
+    void setSourceOwner(int source, int owner);
+
+    void clearSources();
+
+    // Call after the terrain at (x, y) changed
+    void invalidateTile(int x, int y);
+
+    // Full recompute, needed after the map is regenerated or resized
+    void rebuild();
+
+    int getWidth() const;
+
+    int getHeight() const;
+
+    uint8_t getOwner(int x, int y) const;
+
+    uint16_t getDistance(int x, int y) const;
+
+    uint16_t getSource(int x, int y) const;
+
+    // True for owned tiles with a 4-neighbour of a different owner
+    bool isBorder(int x, int y) const;
+
+    const uint8_t *getOwners() const;
+
+    const uint16_t *getDistances() const;
+
+    uint32_t getVersion() const;
+
+    // Tiles settled by Dijkstra so far, to compare incremental and full updates
+    uint64_t getTilesVisited() const;
+
+private:
+    struct Source {
+        int x;
+        int y;
+        int owner;
+        bool alive;
+    };
+
+    uint32_t labelOf(int tile) const;
+
+    void seed(int tile, uint16_t source);
+
+    void clearBox(int x, int y, int radius, uint16_t source);
+
+    void repair();
+
+    void propagate();
+
+    const GameMap *map;
+    int width;
+    int height;
+    uint16_t range;
+    uint32_t version;
+    uint64_t tilesVisited;
+    std::vector<uint8_t> owners;
+    std::vector<uint16_t> distances;
+    std::vector<uint16_t> sources;
+    std::vector<Source> sourceList;
+    std::vector<uint16_t> freeSources;
+    std::vector<int> cleared;
+    // (distance << 48 | source << 32 | tile), smallest first
+    std::priority_queue<uint64_t, std::vector<uint64_t>, std::greater<uint64_t>> open;
+};
+
+#endif
@@ -0,0 +1,197 @@
+#include "Simulation.h"
+#include "../engine/AllocationTracker.h"
+#include "../engine/UnitSystems.h"
+
+static const int UNIT_MOVES = 2;
+static const int UNIT_HP = 10;
+static const int HEAL_PER_TURN = 1;
+static const int RALLY_INTERVAL = 20;
+static const int DIRECTIONS[8][2] = {
+        {-1, -1}, {0, -1}, {1, -1},
+        {-1, 0}, {1, 0},
+        {-1, 1}, {0, 1}, {1, 1}
+};
+
+Simulation::Simulation(GameMap *map, unsigned seed) :
+        map(map),
+        flowFields(map),
+        territory(map),
+        rng(seed),
+        turn(0) {
+
+}
+
+int Simulation::spawnUnits(int players, int unitsPerPlayer) {
+    std::uniform_int_distribution<int> column(0, map->getWidth() - 1);
+    std::uniform_int_distribution<int> row(0, map->getHeight() - 1);
+    int spawned = 0;
+
+    rallyPoints.assign((size_t) players, -1);
+    // Every player looks up a field each turn; any fewer and the LRU order
+    // would evict each field just before it is needed again
+    flowFields.reserve((size_t) players);
+
+    for (int player = 0; player < players; player++) {
+        for (int i = 0; i < unitsPerPlayer; i++) {
+            int x = 0;
+            int y = 0;
+            bool found = false;
+
+            for (int attempt = 0; attempt < 64 && !found; attempt++) {
+                x = column(rng);
+                y = row(rng);
+                found = map->isPassable(x, y);
+            }
+
+            if (!found) {
+                return spawned;
+            }
+
+            Entity unit = entities.createWith(Position{x, y},
+                                              Owner{player},
+                                              Movement{UNIT_MOVES, UNIT_MOVES},
+                                              Health{UNIT_HP, UNIT_HP});
+            spatialIndex.insert(unit, x, y);
+            spawned++;
+        }
+    }
+
+    return spawned;
+}
+
+void Simulation::runTurn() {
+    AllocationScope scope(ALLOC_WORLD);
+
+    if (turn % RALLY_INTERVAL == 0) {
+        pickRallyPoints();
+    }
+
+    resetMovement(&entities);
+    healUnits(&entities, HEAL_PER_TURN);
+    moveUnits();
+    turn++;
+}
+
+std::shared_ptr<const WorldSnapshot> Simulation::snapshot() {
+    AllocationScope scope(ALLOC_WORLD);
+
+    std::shared_ptr<WorldSnapshot> snapshot = std::make_shared<WorldSnapshot>(turn, *map);
+    snapshot->units.reserve(entities.size());
+
+    entities.forEach<Position, Owner, Health>([&snapshot](Entity unit,
+                                                          Position &position,
+                                                          Owner &owner,
+                                                          Health &health) {
+        snapshot->units.push_back(UnitSnapshot{unit, position.x, position.y, owner.player, health.hp});
+    });
+
+    return snapshot;
+}
+
+void Simulation::setTerrain(int x, int y, int terrain) {
+    map->setTerrain(x, y, terrain);
+    flowFields.invalidateTile(x, y);
+    territory.invalidateTile(x, y);
+}
+
+int Simulation::foundCity(int x, int y, int player) {
+    return territory.addSource(x, y, player);
+}
+
+void Simulation::captureCity(int city, int player) {
+    territory.setSourceOwner(city, player);
+}
+
+void Simulation::razeCity(int city) {
+    territory.removeSource(city);
+}
+
+int Simulation::getTurn() {
+    return turn;
+}
+
+GameMap *Simulation::getMap() {
+    return map;
+}
+
+EntityManager *Simulation::getEntities() {
+    return &entities;
+}
+
+SpatialIndex *Simulation::getSpatialIndex() {
+    return &spatialIndex;
+}
+
+FlowFieldCache *Simulation::getFlowFields() {
+    return &flowFields;
+}
+
+InfluenceMap *Simulation::getTerritory() {
+    return &territory;
+}
+
+void Simulation::pickRallyPoints() {
+    std::uniform_int_distribution<int> column(0, map->getWidth() - 1);
+    std::uniform_int_distribution<int> row(0, map->getHeight() - 1);
+
+    for (auto &rallyPoint : rallyPoints) {
+        for (int attempt = 0; attempt < 64; attempt++) {
+            int x = column(rng);
+            int y = row(rng);
+            if (map->isPassable(x, y)) {
+                rallyPoint = y * map->getWidth() + x;
+                break;
+            }
+        }
+    }
+}
+
+void Simulation::moveUnits() {
+    std::uniform_int_distribution<int> direction(0, 7);
+    size_t players = rallyPoints.size();
+
+    // One field per player, shared by all of that player's units. They are
+    // held by reference, since with more players than the cache holds,
+    // later lookups evict fields fetched earlier this turn.
+    rallyFields.resize(players);
+    for (size_t player = 0; player < players; player++) {
+        rallyFields[player] = nullptr;
+        if (rallyPoints[player] >= 0) {
+            rallyFields[player] = flowFields.get(rallyPoints[player] % map->getWidth(),
+                                                 rallyPoints[player] / map->getWidth());
+        }
+    }
+
+    entities.forEach<Position, Movement, Owner>([&](Entity unit,
+                                                     Position &position,
+                                                     Movement &movement,
+                                                     Owner &owner) {
+        const FlowField *field = (size_t) owner.player < players ? rallyFields[owner.player].get() : nullptr;
+
+        while (movement.moves > 0) {
+            int dx;
+            int dy;
+            if (field == nullptr || !field->getStep(position.x, position.y, &dx, &dy)) {
+                // At the rally point, or cut off from it: wander
+                const int *step = DIRECTIONS[direction(rng)];
+                dx = step[0];
+                dy = step[1];
+            }
+
+            int x = position.x + dx;
+            int y = position.y + dy;
+            if (map->inBounds(x, y) && map->isPassable(x, y)) {
+                position.x = x;
+                position.y = y;
+                movement.moves -= map->getMoveCost(x, y);
+            } else {
+                movement.moves--;
+            }
+        }
+
+        spatialIndex.move(unit, position.x, position.y);
+    });
+
+    // Keeps the capacity, so later turns do not reallocate
+    rallyFields.clear();
+}
@@ -0,0 +1,71 @@
+#ifndef CIV_SIMULATION_H
+#define CIV_SIMULATION_H
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "FlowField.h"
+#include "GameMap.h"
+#include "InfluenceMap.h"
+#include "WorldSnapshot.h"
+#include "../engine/EntityManager.h"
+#include "../engine/SpatialIndex.h"
+
+// Headless game state: the map plus every unit, advanced one turn at a
+// time. Nothing here touches SDL, so it runs the same inside the game and
+// in civ_sim.
+class Simulation {
+public:
+    Simulation(GameMap *map, unsigned seed);
+
+    // Returns the number of units actually placed, which is lower than
+    // requested if the map runs out of land
+    int spawnUnits(int players, int unitsPerPlayer);
+
+    void runTurn();
+
+    // Consistent view of the world for other threads. Call between turns
+    // on the thread that runs them; the live state carries on unblocked.
+    std::shared_ptr<const WorldSnapshot> snapshot();
+
+    // Changes terrain, drops any cached paths that crossed the region and
+    // repairs the territory around the tile
+    void setTerrain(int x, int y, int terrain);
+
+    // Returns the city's influence source id, or -1 if the tile cannot hold one
+    int foundCity(int x, int y, int player);
+
+    void captureCity(int city, int player);
+
+    void razeCity(int city);
+
+    int getTurn();
+
+    GameMap *getMap();
+
+    EntityManager *getEntities();
+
+    SpatialIndex *getSpatialIndex();
+
+    FlowFieldCache *getFlowFields();
+
+    InfluenceMap *getTerritory();
+
+private:
+    void pickRallyPoints();
+
+    void moveUnits();
+
+    GameMap *map;
+    EntityManager entities;
+    SpatialIndex spatialIndex;
+    FlowFieldCache flowFields;
+    InfluenceMap territory;
+    std::vector<int> rallyPoints;
+    std::vector<std::shared_ptr<const FlowField>> rallyFields;
+    std::mt19937 rng;
+    int turn;
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef CIV_TERRAINREGISTRY_H
+#define CIV_TERRAINREGISTRY_H
+
+#include <cstdint>
+
+#include "../engine/constants.h"
+
+// Compile-time description of every terrain type. The tile ids in
+// constants.h (GRASS1_TILE .. HILLS4_TILE) are terrain * TERRAIN_VARIANTS +
+// variant, so every lookup below is a division and an array index.
+
+const int IMPASSABLE = -1;
+const int TERRAIN_VARIANTS = 4;
+
+const uint32_t TERRAIN_FLAG_WATER = 1;
+const uint32_t TERRAIN_FLAG_ROUGH = 2;
+
+enum TerrainType {
+    TERRAIN_GRASS,
+    TERRAIN_WATER,
+    TERRAIN_MOUNTAIN,
+    TERRAIN_DESERT,
+    TERRAIN_FOREST,
+    TERRAIN_MARSH,
+    TERRAIN_DIRT,
+    TERRAIN_HILLS,
+    NUM_TERRAIN_TYPES
+};
+
+struct TerrainInfo {
+    const char *name;
+    // Sprite sheet cell of the first variant; variants follow to the right
+    int atlasColumn;
+    int atlasRow;
+    int moveCost;
+    int food;
+    int production;
+    int gold;
+    int science;
+    uint32_t flags;
+};
+
+constexpr TerrainInfo TERRAIN_TABLE[NUM_TERRAIN_TYPES] = {
+        {"Grassland", 0, 0, 1,          2, 0, 0, 0, 0},
+        {"Ocean",     4, 0, IMPASSABLE, 1, 0, 2, 0, TERRAIN_FLAG_WATER},
+        {"Mountains", 0, 1, 3,          0, 1, 0, 0, TERRAIN_FLAG_ROUGH},
+        {"Desert",    4, 1, 1,          0, 1, 0, 0, 0},
+        {"Forest",    0, 2, 2,          1, 2, 0, 0, TERRAIN_FLAG_ROUGH},
+        {"Marsh",     4, 2, 2,          1, 0, 0, 0, 0},
+        {"Dirt",      0, 3, 1,          1, 1, 0, 0, 0},
+        {"Hills",     0, 4, 2,          1, 0, 0, 0, TERRAIN_FLAG_ROUGH}
+};
+
+constexpr TerrainType terrainType(int tile) {
+    return (TerrainType) (tile / TERRAIN_VARIANTS);
+}
+
+constexpr const TerrainInfo &terrainInfo(int tile) {
+    return TERRAIN_TABLE[tile / TERRAIN_VARIANTS];
+}
+
+constexpr int terrainClipX(int tile) {
+    return (terrainInfo(tile).atlasColumn + tile % TERRAIN_VARIANTS) * TILE_WIDTH;
+}
+
+constexpr int terrainClipY(int tile) {
+    return terrainInfo(tile).atlasRow * TILE_HEIGHT;
+}
+
+static_assert(NUM_TERRAIN_TYPES * TERRAIN_VARIANTS == NUM_TERRAIN_CLIPS, "Terrain table out of sync");
+static_assert(terrainType(WATER1_TILE) == TERRAIN_WATER && terrainType(HILLS4_TILE) == TERRAIN_HILLS,
+              "Tile ids in constants.h no longer follow the terrain order");
+static_assert(terrainClipX(MARSH3_TILE) == TILE_WIDTH * 6 && terrainClipY(MARSH3_TILE) == TILE_HEIGHT * 2,
+              "Terrain atlas cells no longer match the sprite sheet");
+static_assert(terrainClipX(DIRT1_TILE) == 0 && terrainClipY(DIRT1_TILE) == TILE_HEIGHT * 3,
+              "Terrain atlas cells no longer match the sprite sheet");
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef CIV_WORLDSNAPSHOT_H
+#define CIV_WORLDSNAPSHOT_H
+
+#include <vector>
+
+#include "GameMap.h"
+#include "../engine/Entity.h"
+
+struct UnitSnapshot {
+    Entity entity;
+    int x;
+    int y;
+    int player;
+    int hp;
+};
+
+// Read-only copy of the simulation between turns, handed to AI and
+// autosave threads through a shared_ptr. The map shares its terrain chunks
+// with the live one until the main thread writes to them; units change
+// every turn, so they are copied outright.
+struct WorldSnapshot {
+    WorldSnapshot(int turn, const GameMap &map) :
+            turn(turn),
+            map(map) {
+
+    }
+
+    int turn;
+    GameMap map;
+    std::vector<UnitSnapshot> units;
+};
+
+#endif